@@ -8,6 +8,12 @@
  * Le paramètre \p preemption vaut 1 si les préemptions sont autorisées, sinon ça vaut 0.
  * Le paramètre \p balanced_tree vaut 1 si les arbres binaires de recherche utilisé dans la structure d'événements
  * et dans la file d'attente de "ready tasks" sont équilibrés, sinon ça vaut 0.
+ * Il vaut 2 si la structure d'événements est un tas d-aire (la file d'attente est alors équilibrée),
+ * 3 si les libérations sont triées une fois puis fusionnées avec un tas des fins d'exécution,
+ * 4 si la structure d'événements est un tas radix, 5 si c'est une file calendrier,
+ * 6 si les deux arbres sont des arbres rouge-noir au lieu d'arbres AVL,
+ * 7 si la file d'attente est un arbre B+ (la structure d'événements est alors un arbre AVL),
+ * et 8 si les deux structures sont des arbres AVL spécialisés pour leurs clés (voir tree_template.h).
  * 
  * @param[in] I 
  * @param[in] num_m 
@@ -16,4 +22,26 @@
  */
 struct schedule_t * create_schedule(Instance I, int num_m, int preemption, int balanced_tree);
 
+/**
+ * @brief Même algorithme que create_schedule, avec un ordonnancement en flux (voir set_schedule_sink) :
+ * chaque segment terminé est passé à la fonction \p sink (avec l'argument \p arg) dès qu'il ne peut plus
+ * être modifié, puis libéré. L'ordonnancement restitué ne contient plus de segment, mais ses métriques
+ * (get_makespan, get_schedule_metrics) sont celles de tout l'ordonnancement.
+ * Les libérations sont lues une à une dans l'ordre des dates de libération : l'ensemble des événements
+ * ne contient que les fins d'exécution en cours et la prochaine libération. En plus de l'instance,
+ * la mémoire utilisée est donc en O(num_m + taille de la file d'attente) si l'instance est triée
+ * par date de libération (puis par durée) ; sinon, un tableau de n pointeurs sert à la parcourir dans cet ordre.
+ * 
+ * @param[in] I 
+ * @param[in] num_m 
+ * @param[in] preemption 
+ * @param[in] balanced_tree 
+ * @param[in] sink 
+ * @param[in] arg 
+ * @return struct schedule_t* 
+ */
+struct schedule_t * create_schedule_streaming(Instance I, int num_m, int preemption, int balanced_tree,
+						void (*sink)(void * arg, int machine, const struct task_t * task, unsigned long bt, unsigned long et),
+						void * arg);
+
 #endif // _ALGO_H_
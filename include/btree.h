@@ -0,0 +1,189 @@
+#ifndef _BTREE_H_
+#define _BTREE_H_
+
+/**
+ * @brief
+ * Le fichier définit un arbre B+ générique : un conteneur ordonné à nœuds larges
+ * dont les clés, stockées par valeur, sont rangées côte à côte dans un tableau de chaque nœud.
+ * Une opération visite un nœud par niveau, et un nœud tient dans quelques lignes de cache :
+ * la hauteur, et donc le nombre de défauts de cache, est d'environ log_b(n) avec b de l'ordre de 100,
+ * au lieu de log2(n) pour un arbre binaire de recherche.
+ */
+
+#include <stddef.h>
+
+#include "pool.h"
+
+/**
+ * @brief Taille visée (en octets) d'un nœud d'un arbre B+ : le nombre de clés par nœud en découle.
+ */
+#define BTREE_NODE_SIZE 2048
+
+/**
+ * @brief Hauteur maximale d'un arbre B+ (largement suffisante : chaque nœud interne a au moins deux fils).
+ */
+#define BTREE_MAX_HEIGHT 40
+
+/**
+ * @brief
+ * Un nœud d'un arbre B+ contient
+ * (+) l'indication (leaf) que c'est une feuille,
+ * (+) le nombre (numkeys) de clés du nœud,
+ * (+) la référence next vers la feuille suivante (feuilles seulement, NULL pour la dernière), et
+ * (+) le tableau ptrs des références :
+ *     les données des numkeys éléments pour une feuille,
+ *     les numkeys+1 fils pour un nœud interne.
+ * Les clés sont rangées par valeur après le tableau ptrs, à la position keysOffset de l'arbre
+ * (voir btree_t) : un nœud est un seul bloc de mémoire.
+ * Dans un nœud interne, tous les éléments du fils i sont inférieurs ou égaux à la clé i,
+ * et tous ceux du fils i+1 lui sont supérieurs ou égaux.
+ */
+struct btree_node_t {
+	int leaf;
+	int numkeys;
+	struct btree_node_t * next;
+	void * ptrs[];
+};
+
+/**
+ * @brief
+ * L'arbre B+ est une structure contenant :
+ * (+) une référence (root) sur sa racine, qui est une feuille (éventuellement vide) si l'arbre est petit,
+ * (+) une référence (first) sur sa première feuille, qui contient le minimum,
+ * (+) le nombre d'éléments (numelm),
+ * (+) le nombre maximum (capacity) de clés d'un nœud, déduit de BTREE_NODE_SIZE et de keySize :
+ *     un nœud autre que la racine a au moins capacity/2 clés,
+ * (+) la taille (keySize) des clés, stockées par valeur dans les nœuds,
+ * (+) la position (keysOffset) des clés dans un nœud,
+ * (+) un pointeur de fonction pour comparer ses clés,
+ * (+) un pointeur de fonction pour afficher ses clés,
+ * (+) un pointeur de fonction pour afficher ses données,
+ * (+) un pointeur de fonction pour libérer la mémoire de ses données, et
+ * (+) la réserve (pool) dans laquelle sont alloués ses nœuds.
+ */
+struct btree_t {
+	struct btree_node_t * root;
+	struct btree_node_t * first;
+	int numelm;
+	int capacity;
+	size_t keySize;
+	size_t keysOffset;
+	int (*preceed)(const void * a, const void * b);
+	void (*viewKey)(const void * key);
+	void (*viewData)(const void * data);
+	void (*freeData)(void * data);
+	struct pool_t * pool;
+};
+
+/**
+ * @brief
+ * Construire un arbre B+ vide dont les clés, de \p keySize octets, sont stockées par valeur :
+ * btree_insert copie la clé, l'appelant garde donc la propriété de la clé qu'il passe.
+ * Les clés disparaissent avec leurs éléments : il n'y a pas de pointeur de fonction freeKey.
+ *
+ * @param keySize Taille en octets d'une clé.
+ * @param preceed Pointeur de fonction pour comparer deux clés de l'arbre.
+ * @param viewKey Pointeur de fonction pour afficher une clé de l'arbre.
+ * @param viewData Pointeur de fonction pour afficher une donnée de l'arbre.
+ * @param freeData Pointeur de fonction pour libérer la mémoire d'une donnée de l'arbre.
+ * @return struct btree_t*
+ */
+struct btree_t * new_btree(size_t keySize, int (*preceed)(const void *, const void *),
+						void (*viewKey)(const void *), void (*viewData)(const void *),
+						void (*freeData)(void *));
+
+/**
+ * @brief Renvoie 1 si l'arbre B+ \p B est vide, sinon renvoie 0.
+ *
+ * @param[in] B
+ * @return int
+ */
+int btree_is_empty(const struct btree_t * B);
+
+/**
+ * @brief Restitue la taille (nombre d'éléments) de l'arbre B+ \p B.
+ *
+ * @param[in] B
+ * @return int
+ */
+int get_btree_size(const struct btree_t * B);
+
+/**
+ * @brief
+ * Supprimer l'arbre B+ \p B et tous ses nœuds.
+ * Si \p deleteData vaut 1, la mémoire des données est libérée avec freeData.
+ *
+ * @param[in] B
+ * @param[in] deleteData
+ */
+void delete_btree(struct btree_t * B, int deleteData);
+
+/**
+ * @brief Afficher les éléments de l'arbre B+ \p B dans l'ordre croissant des clés.
+ *
+ * @param[in] B
+ */
+void view_btree(const struct btree_t * B);
+
+/**
+ * @brief
+ * Ajouter dans l'arbre B+ \p B une copie de la clé \p key avec la donnée \p data.
+ * Un élément de clé égale à celle d'éléments déjà présents est placé après eux
+ * (l'ordre d'insertion des clés égales est conservé, comme dans tree_insert).
+ * Un nœud plein est coupé en deux, ce qui peut remonter jusqu'à la racine.
+ *
+ * @param[in] B
+ * @param[in] key
+ * @param[in] data
+ */
+void btree_insert(struct btree_t * B, const void * key, void * data);
+
+/**
+ * @brief Restitue la clé minimum de l'arbre B+ non vide \p B (la copie stockée dans l'arbre), en temps constant.
+ *
+ * @param[in] B
+ * @return void*
+ */
+void * get_btree_min_key(const struct btree_t * B);
+
+/**
+ * @brief Restitue la donnée de l'élément de clé minimum de l'arbre B+ non vide \p B, en temps constant.
+ *
+ * @param[in] B
+ * @return void*
+ */
+void * get_btree_min_data(const struct btree_t * B);
+
+/**
+ * @brief
+ * Restitue la donnée du premier élément (dans l'ordre croissant) de clé égale à \p key
+ * dans l'arbre B+ \p B, NULL s'il n'y en a pas.
+ *
+ * @param[in] B
+ * @param[in] key
+ * @return void*
+ */
+void * btree_find(const struct btree_t * B, const void * key);
+
+/**
+ * @brief
+ * Supprime de l'arbre B+ \p B le premier élément de clé égale à \p key et restitue sa donnée,
+ * NULL s'il n'y en a pas. Un nœud qui n'a plus assez de clés emprunte une clé à un voisin
+ * ou fusionne avec lui, ce qui peut remonter jusqu'à la racine.
+ * NB : \p key peut être la clé minimum (voir get_btree_min_key), mais elle ne doit plus être lue après l'appel.
+ *
+ * @param[in] B
+ * @param[in] key
+ * @return void*
+ */
+void * btree_remove(struct btree_t * B, const void * key);
+
+/**
+ * @brief Supprime de l'arbre B+ non vide \p B l'élément de clé minimum et restitue sa donnée.
+ *
+ * @param[in] B
+ * @return void*
+ */
+void * btree_pop_min(struct btree_t * B);
+
+#endif // _BTREE_H_
@@ -0,0 +1,182 @@
+#ifndef _CALENDAR_QUEUE_H_
+#define _CALENDAR_QUEUE_H_
+
+/**
+ * @brief
+ * Le fichier définit une file calendrier (calendar queue) : une file de priorité
+ * sur des clés datées, découpée en seaux correspondant à des intervalles de temps
+ * de même largeur (les "jours" d'une "année" qui se répète).
+ * Le nombre de seaux et leur largeur s'adaptent au nombre d'éléments.
+ */
+
+#include "heap.h"
+
+/**
+ * @brief Nombre minimum de seaux d'une file calendrier.
+ */
+#define CALENDAR_MIN_BUCKETS 2
+
+/**
+ * @brief Nombre de clés échantillonnées pour estimer la largeur des seaux lors d'un redimensionnement.
+ */
+#define CALENDAR_SAMPLE_SIZE 25
+
+/**
+ * @brief
+ * Un seau d'une file calendrier est un tableau trié par clé croissante
+ * (les clés égales dans leur ordre d'insertion, voir heap_node_preceed) contenant
+ * (+) ses éléments (nodes), rangés aux indices first, ..., first+numelm-1,
+ * (+) l'indice (first) du plus petit élément,
+ * (+) le nombre d'éléments (numelm), et
+ * (+) la capacité du tableau (capacity).
+ */
+struct calendar_bucket_t {
+	struct heap_node_t * nodes;
+	int first;
+	int numelm;
+	int capacity;
+};
+
+/**
+ * @brief
+ * La file calendrier est une structure contenant :
+ * (+) le tableau (buckets) de ses nbuckets seaux :
+ *     une clé de date t est dans le seau (t / width) modulo nbuckets,
+ * (+) le nombre de seaux (nbuckets),
+ * (+) la largeur (width) d'un seau,
+ * (+) le seau courant (lastbucket), la fin (buckettop) de son intervalle pour l'année courante
+ *     et la date (lastprio) de la dernière clé extraite,
+ * (+) le nombre d'éléments (numelm),
+ * (+) l'indication (resizable) que le redimensionnement est autorisé,
+ * (+) le numéro d'insertion (seq) du prochain élément, conservé lors des redimensionnements,
+ * (+) un pointeur de fonction pour obtenir la date d'une clé,
+ * (+) un pointeur de fonction pour comparer ses clés,
+ * (+) des pointeurs de fonction pour afficher ses clés et ses données, et
+ * (+) des pointeurs de fonction pour libérer la mémoire de ses clés et de ses données.
+ */
+struct calendar_queue_t {
+	struct calendar_bucket_t * buckets;
+	int nbuckets;
+	unsigned long width;
+	int lastbucket;
+	unsigned long buckettop;
+	unsigned long lastprio;
+	int numelm;
+	int resizable;
+	unsigned long seq;
+	unsigned long (*time)(const void * key);
+	int (*preceed)(const void * a, const void * b);
+	void (*viewKey)(const void * key);
+	void (*viewData)(const void * data);
+	void (*freeKey)(void * key);
+	void (*freeData)(void * data);
+};
+
+/**
+ * @brief Construire une file calendrier vide.
+ *
+ * @param time Pointeur de fonction pour obtenir la date d'une clé.
+ * @param preceed Pointeur de fonction pour comparer deux clés.
+ * @param viewKey Pointeur de fonction pour afficher une clé.
+ * @param viewData Pointeur de fonction pour afficher une donnée.
+ * @param freeKey Pointeur de fonction pour libérer la mémoire d'une clé.
+ * @param freeData Pointeur de fonction pour libérer la mémoire d'une donnée.
+ * @return struct calendar_queue_t*
+ */
+struct calendar_queue_t * new_calendar_queue(unsigned long (*time)(const void *),
+						int (*preceed)(const void *, const void *),
+						void (*viewKey)(const void *), void (*viewData)(const void *),
+						void (*freeKey)(void *), void (*freeData)(void *));
+
+/**
+ * @brief Renvoie 1 si la file calendrier \p C est vide, sinon renvoie 0.
+ *
+ * @param[in] C
+ * @return int
+ */
+int calendar_queue_is_empty(const struct calendar_queue_t * C);
+
+/**
+ * @brief Restitue la taille (nombre d'éléments) de la file calendrier \p C.
+ *
+ * @param[in] C
+ * @return int
+ */
+int get_calendar_queue_size(const struct calendar_queue_t * C);
+
+/**
+ * @brief Supprimer la file calendrier \p C (voir delete_tree pour \p deleteKey et \p deleteData).
+ *
+ * @param[in] C
+ * @param[in] deleteKey
+ * @param[in] deleteData
+ */
+void delete_calendar_queue(struct calendar_queue_t * C, int deleteKey, int deleteData);
+
+/**
+ * @brief Afficher les éléments de la file calendrier \p C, seau par seau.
+ *
+ * @param[in] C
+ */
+void view_calendar_queue(const struct calendar_queue_t * C);
+
+/**
+ * @brief
+ * Ajouter dans la file calendrier \p C un élément de clé \p key et de donnée \p data.
+ * Le nombre de seaux est doublé quand il y a plus de deux éléments par seau.
+ *
+ * @param[in] C
+ * @param[in] key
+ * @param[in] data
+ */
+void calendar_queue_insert(struct calendar_queue_t * C, void * key, void * data);
+
+/**
+ * @brief
+ * Restitue l'élément de clé minimum de la file calendrier \p C sans le retirer.
+ * La file \p C ne doit pas être vide.
+ * NB : la recherche avance le seau courant, d'où le paramètre non constant.
+ *
+ * @param[in] C
+ * @return struct heap_node_t*
+ */
+struct heap_node_t * calendar_queue_min(struct calendar_queue_t * C);
+
+/**
+ * @brief
+ * Retire l'élément de clé minimum de la file calendrier \p C et restitue sa donnée.
+ * La clé est restituée par \p key (voir heap_remove_min).
+ * Le nombre de seaux est divisé par deux quand il y a moins d'un élément pour deux seaux.
+ *
+ * @param[in] C
+ * @param[out] key
+ * @return void*
+ */
+void * calendar_queue_remove_min(struct calendar_queue_t * C, void ** key);
+
+/**
+ * @brief
+ * Retire de la file calendrier \p C l'élément dont la clé est égale à \p key et restitue sa donnée.
+ * Seul le seau de la date de \p key est parcouru (recherche dichotomique).
+ * La clé de l'élément retiré est libérée avec freeKey (si freeKey n'est pas NULL).
+ * Renvoie NULL si aucun élément ne correspond.
+ *
+ * @param[in] C
+ * @param[in] key
+ * @return void*
+ */
+void * calendar_queue_remove(struct calendar_queue_t * C, void * key);
+
+/**
+ * @brief
+ * Retire de la file calendrier \p C l'élément dont la clé est \p handle elle-même (même adresse)
+ * et restitue sa donnée (voir heap_remove_handle).
+ * Renvoie NULL si aucun élément ne correspond.
+ *
+ * @param[in] C
+ * @param[in] handle
+ * @return void*
+ */
+void * calendar_queue_remove_handle(struct calendar_queue_t * C, void * handle);
+
+#endif // _CALENDAR_QUEUE_H_
@@ -0,0 +1,220 @@
+#ifndef _EVENT_QUEUE_H_
+#define _EVENT_QUEUE_H_
+
+/**
+ * @brief
+ * Le fichier définit l'ensemble des événements de la simulation :
+ * une file de priorité générique dont l'implémentation (le "backend")
+ * est choisie à la construction.
+ */
+
+#include <stddef.h>
+
+/**
+ * @brief Les implémentations possibles de l'ensemble des événements.
+ * Les valeurs 0 et 1 correspondent aux valeurs de balanced de new_tree (TREE_BST et TREE_AVL).
+ */
+#define EVENT_QUEUE_BST 0	// arbre binaire de recherche non-équilibré
+#define EVENT_QUEUE_AVL 1	// arbre binaire de recherche équilibré (AVL)
+#define EVENT_QUEUE_HEAP 2	// tas d-aire stocké dans un tableau
+#define EVENT_QUEUE_STREAM 3	// flot trié des premières insertions fusionné avec un tas d-aire
+#define EVENT_QUEUE_RADIX 4	// tas radix (file monotone sur les dates)
+#define EVENT_QUEUE_CALENDAR 5	// file calendrier (seaux de dates de largeur adaptative)
+#define EVENT_QUEUE_RBT 6	// arbre binaire de recherche équilibré (rouge-noir)
+#define EVENT_QUEUE_BTREE 7	// arbre B+ à nœuds larges (clés copiées, sans référence sur les éléments)
+
+/**
+ * @brief
+ * L'ensemble des événements est une structure contenant :
+ * (+) le type de son implémentation (type),
+ * (+) l'arbre binaire de recherche (tree) si type vaut EVENT_QUEUE_BST, EVENT_QUEUE_AVL ou EVENT_QUEUE_RBT,
+ * (+) le tas d-aire (heap) si type vaut EVENT_QUEUE_HEAP ou EVENT_QUEUE_STREAM,
+ * (+) le flot (stream) si type vaut EVENT_QUEUE_STREAM : un tableau de stream_size éléments
+ *     dont les éléments d'indice inférieur à cursor ont déjà été extraits,
+ *     et le nombre (stream_removed) d'éléments après cursor déjà retirés (leur référence vaut NULL),
+ * (+) l'indication (streaming) que les insertions alimentent encore le flot,
+ * (+) le tas radix (radix) si type vaut EVENT_QUEUE_RADIX,
+ * (+) la file calendrier (calendar) si type vaut EVENT_QUEUE_CALENDAR,
+ * (+) l'arbre B+ (btree) si type vaut EVENT_QUEUE_BTREE,
+ * (+) la taille (keySize) des clés si l'ensemble stocke des copies de ses clés, 0 sinon,
+ * (+) la réserve (keys) des copies des clés si keySize n'est pas nul et que type n'est pas
+ *     EVENT_QUEUE_BST, EVENT_QUEUE_AVL, EVENT_QUEUE_RBT ou EVENT_QUEUE_BTREE (les arbres copient les clés
+ *     dans leurs nœuds), NULL sinon,
+ * (+) un pointeur de fonction pour comparer ses clés, et
+ * (+) des pointeurs de fonction pour libérer la mémoire de ses clés et de ses données.
+ * Les champs tree, heap, radix, calendar et btree qui ne correspondent pas à type valent NULL.
+ *
+ * NB : en mode EVENT_QUEUE_STREAM, toutes les insertions faites avant le premier accès
+ * au minimum (par exemple les libérations de toutes les tâches) sont stockées dans le flot,
+ * qui est trié une seule fois lors de ce premier accès puis consommé avec le curseur.
+ * Les insertions suivantes (les fins d'exécution, au plus une par machine)
+ * vont dans le tas, qui reste donc petit. Les références des éléments du flot sont allouées
+ * dans la réserve du tas, avec bucket valant 1 (0 pour les éléments du tas).
+ */
+struct event_queue_t {
+	int type;
+	struct tree_t * tree;
+	struct heap_t * heap;
+	struct heap_node_t * stream;
+	int stream_size;
+	int stream_capacity;
+	int cursor;
+	int stream_removed;
+	int streaming;
+	struct radix_heap_t * radix;
+	struct calendar_queue_t * calendar;
+	struct btree_t * btree;
+	size_t keySize;
+	struct pool_t * keys;
+	int (*preceed)(const void * a, const void * b);
+	void (*freeKey)(void * key);
+	void (*freeData)(void * data);
+};
+
+/**
+ * @brief Construire un ensemble d'événements vide.
+ *
+ * @param type L'implémentation à utiliser (EVENT_QUEUE_BST, EVENT_QUEUE_AVL, EVENT_QUEUE_HEAP,
+ * EVENT_QUEUE_STREAM, EVENT_QUEUE_RADIX, EVENT_QUEUE_CALENDAR, EVENT_QUEUE_RBT ou EVENT_QUEUE_BTREE).
+ * NB : EVENT_QUEUE_BTREE exige que keySize ne soit pas nul.
+ * @param keySize Si keySize n'est pas nul, l'ensemble stocke une copie de chaque clé insérée
+ * (de keySize octets) : l'appelant garde la propriété de ses clés et freeKey est ignoré.
+ * @param preceed Pointeur de fonction pour comparer deux clés.
+ * @param time Pointeur de fonction pour obtenir la date d'une clé
+ * (nécessaire pour EVENT_QUEUE_RADIX et EVENT_QUEUE_CALENDAR, peut valoir NULL sinon).
+ * @param viewKey Pointeur de fonction pour afficher une clé.
+ * @param viewData Pointeur de fonction pour afficher une donnée.
+ * @param freeKey Pointeur de fonction pour libérer la mémoire d'une clé.
+ * @param freeData Pointeur de fonction pour libérer la mémoire d'une donnée.
+ * @return struct event_queue_t*
+ */
+struct event_queue_t * new_event_queue(int type, size_t keySize, int (*preceed)(const void *, const void *),
+						unsigned long (*time)(const void *),
+						void (*viewKey)(const void *), void (*viewData)(const void *),
+						void (*freeKey)(void *), void (*freeData)(void *));
+
+/**
+ * @brief Renvoie 1 si l'ensemble \p EQ est vide, sinon renvoie 0.
+ *
+ * @param[in] EQ
+ * @return int
+ */
+int event_queue_is_empty(const struct event_queue_t * EQ);
+
+/**
+ * @brief Restitue la taille (nombre d'événements) de l'ensemble \p EQ.
+ *
+ * @param[in] EQ
+ * @return int
+ */
+int get_event_queue_size(const struct event_queue_t * EQ);
+
+/**
+ * @brief Supprimer l'ensemble \p EQ (voir delete_tree pour \p deleteKey et \p deleteData).
+ *
+ * @param[in] EQ
+ * @param[in] deleteKey
+ * @param[in] deleteData
+ */
+void delete_event_queue(struct event_queue_t * EQ, int deleteKey, int deleteData);
+
+/**
+ * @brief Afficher les événements de l'ensemble \p EQ.
+ *
+ * @param[in] EQ
+ */
+void view_event_queue(const struct event_queue_t * EQ);
+
+/**
+ * @brief
+ * Ajouter dans l'ensemble \p EQ un événement de clé \p key et de donnée \p data
+ * et restituer une référence (handle) sur cet événement, valable jusqu'à son retrait,
+ * pour le retirer avec event_queue_remove_handle :
+ * (+) le nœud de l'arbre pour EVENT_QUEUE_BST, EVENT_QUEUE_AVL et EVENT_QUEUE_RBT,
+ * (+) NULL pour EVENT_QUEUE_BTREE, qui ne permet pas le retrait par référence,
+ * (+) la référence struct heap_handle_t de l'élément pour EVENT_QUEUE_HEAP, EVENT_QUEUE_STREAM
+ *     et EVENT_QUEUE_RADIX, qui tient à jour sa position : le retrait coûte O(log n),
+ * (+) la clé stockée (la copie de \p key si l'ensemble copie ses clés) pour EVENT_QUEUE_CALENDAR.
+ *
+ * @param[in] EQ
+ * @param[in] key
+ * @param[in] data
+ * @return void*
+ */
+void * event_queue_insert(struct event_queue_t * EQ, void * key, void * data);
+
+/**
+ * @brief
+ * Ajouter dans l'ensemble \p EQ les \p n événements de clés \p keys et de données \p data.
+ * Si l'ensemble est un arbre vide et que les clés sont déjà triées (voir tree_keys_are_sorted),
+ * l'arbre est construit directement en O(n) avec tree_build_from_sorted ;
+ * sinon les événements sont ajoutés un par un avec event_queue_insert.
+ *
+ * @param[in] EQ
+ * @param[in] keys
+ * @param[in] data
+ * @param[in] n
+ */
+void event_queue_insert_all(struct event_queue_t * EQ, void ** keys, void ** data, int n);
+
+/**
+ * @brief Restitue la clé du prochain événement (clé minimum) de l'ensemble \p EQ.
+ * L'ensemble \p EQ ne doit pas être vide.
+ *
+ * @param[in] EQ
+ * @return void*
+ */
+void * get_event_queue_min_key(struct event_queue_t * EQ);
+
+/**
+ * @brief Restitue la donnée du prochain événement (clé minimum) de l'ensemble \p EQ.
+ * L'ensemble \p EQ ne doit pas être vide.
+ *
+ * @param[in] EQ
+ * @return void*
+ */
+void * get_event_queue_min_data(struct event_queue_t * EQ);
+
+/**
+ * @brief
+ * Retire le prochain événement (clé minimum) de l'ensemble \p EQ et restitue sa donnée.
+ * La clé de l'événement est restituée par \p key : sa mémoire n'est pas libérée,
+ * elle appartient désormais à l'appelant. Si \p key vaut NULL, la clé est libérée avec freeKey.
+ * Si l'ensemble stocke des copies de ses clés, \p key doit valoir NULL
+ * (la clé se lit avant l'extraction avec get_event_queue_min_key).
+ *
+ * @param[in] EQ
+ * @param[out] key
+ * @return void*
+ */
+void * event_queue_pop_min(struct event_queue_t * EQ, void ** key);
+
+/**
+ * @brief
+ * Retire de l'ensemble \p EQ l'événement de clé égale à \p key et restitue sa donnée.
+ * L'événement existe obligatoirement dans l'ensemble \p EQ.
+ * La mémoire de la clé stockée dans l'ensemble est libérée (avec freeKey),
+ * celle de \p key reste à la charge de l'appelant.
+ * Si l'ensemble stocke des copies de ses clés dans une réserve, la copie n'est rendue
+ * à la réserve qu'à la suppression de l'ensemble.
+ *
+ * @param[in] EQ
+ * @param[in] key
+ * @return void*
+ */
+void * event_queue_remove(struct event_queue_t * EQ, void * key);
+
+/**
+ * @brief
+ * Retire de l'ensemble \p EQ l'événement de référence \p handle (restituée par event_queue_insert)
+ * et restitue sa donnée. Contrairement à event_queue_remove, il n'y a pas de clé à reconstruire
+ * et c'est bien cet événement qui est retiré, même si d'autres ont une clé égale.
+ * La mémoire de la clé stockée est libérée (avec freeKey, ou rendue à la réserve des copies).
+ *
+ * @param[in] EQ
+ * @param[in] handle
+ * @return void*
+ */
+void * event_queue_remove_handle(struct event_queue_t * EQ, void * handle);
+
+#endif // _EVENT_QUEUE_H_
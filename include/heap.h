@@ -0,0 +1,223 @@
+#ifndef _HEAP_H_
+#define _HEAP_H_
+
+/**
+ * @brief
+ * Le fichier définit un tas (file de priorité) d-aire générique
+ * dont les éléments sont stockés dans un tableau contigu.
+ */
+
+/**
+ * @brief Arité utilisée par défaut pour les tas d-aires.
+ */
+#define HEAP_DEFAULT_ARITY 4
+
+struct pool_t;
+
+/**
+ * @brief
+ * La référence (handle) d'un élément d'un tas contient
+ * (+) l'indice (index) de l'élément dans le tableau du tas, tenu à jour à chaque déplacement, et
+ * (+) le seau (bucket) de l'élément : le tas n'y touche pas, le champ sert aux structures
+ *     qui rangent aussi leurs éléments ailleurs que dans le tas (voir radix_heap_t et event_queue_t).
+ * Les références sont allouées dans la réserve (handles) du tas et restent valides
+ * jusqu'au retrait de leur élément.
+ */
+struct heap_handle_t {
+	int index;
+	int bucket;
+};
+
+/**
+ * @brief
+ * Un élément d'un tas contient
+ * (+) une clé (key),
+ * (+) une donnée (data),
+ * (+) son numéro d'insertion (seq), qui départage les clés égales : la première insérée passe devant,
+ *     comme dans un arbre binaire de recherche (voir tree_insert), et
+ * (+) sa référence (handle), NULL pour les éléments rangés hors d'un tas (voir calendar_queue_t).
+ * Les éléments sont stockés par valeur dans le tableau du tas.
+ */
+struct heap_node_t {
+	void * key;
+	void * data;
+	unsigned long seq;
+	struct heap_handle_t * handle;
+};
+
+/**
+ * @brief
+ * Renvoie 1 si l'élément \p a passe avant l'élément \p b : sa clé précède celle de \p b
+ * (avec \p preceed), ou les deux clés sont égales et \p a a été inséré avant \p b.
+ *
+ * @param[in] preceed
+ * @param[in] a
+ * @param[in] b
+ * @return int
+ */
+static inline int heap_node_preceed(int (*preceed)(const void *, const void *),
+						const struct heap_node_t * a, const struct heap_node_t * b) {
+	if (preceed(a->key, b->key)) {
+		return 1;
+	}
+	return a->seq < b->seq && !preceed(b->key, a->key);
+}
+
+/**
+ * @brief
+ * Le tas d-aire est une structure contenant :
+ * (+) le tableau (nodes) de ses éléments :
+ *     les fils de l'élément d'indice i sont aux indices arity*i+1, ..., arity*i+arity,
+ * (+) le nombre d'éléments (numelm),
+ * (+) la capacité du tableau (capacity),
+ * (+) l'arité du tas (arity),
+ * (+) la réserve (handles) des références de ses éléments,
+ * (+) le numéro d'insertion (seq) du prochain élément ajouté avec heap_insert,
+ * (+) un pointeur de fonction pour comparer ses clés,
+ * (+) un pointeur de fonction pour afficher ses clés,
+ * (+) un pointeur de fonction pour afficher ses données,
+ * (+) un pointeur de fonction pour libérer la mémoire de ses clés, et
+ * (+) un pointeur de fonction pour libérer la mémoire de ses données.
+ */
+struct heap_t {
+	struct heap_node_t * nodes;
+	int numelm;
+	int capacity;
+	int arity;
+	struct pool_t * handles;
+	unsigned long seq;
+	int (*preceed)(const void * a, const void * b);
+	void (*viewKey)(const void * key);
+	void (*viewData)(const void * data);
+	void (*freeKey)(void * key);
+	void (*freeData)(void * data);
+};
+
+/**
+ * @brief Construire un tas d-aire vide.
+ *
+ * @param arity Nombre de fils de chaque élément (au moins 2).
+ * @param preceed Pointeur de fonction pour comparer deux clés du tas.
+ * @param viewKey Pointeur de fonction pour afficher la clé d'un élément du tas.
+ * @param viewData Pointeur de fonction pour afficher la donnée d'un élément du tas.
+ * @param freeKey Pointeur de fonction pour libérer la mémoire de la clé d'un élément du tas.
+ * @param freeData Pointeur de fonction pour libérer la mémoire de la donnée d'un élément du tas.
+ * @return struct heap_t*
+ */
+struct heap_t * new_heap(int arity, int (*preceed)(const void *, const void *),
+						void (*viewKey)(const void *), void (*viewData)(const void *),
+						void (*freeKey)(void *), void (*freeData)(void *));
+
+/**
+ * @brief Renvoie 1 si le tas \p H est vide, sinon renvoie 0.
+ *
+ * @param[in] H
+ * @return int
+ */
+int heap_is_empty(const struct heap_t * H);
+
+/**
+ * @brief Restitue la taille (nombre d'éléments) du tas \p H.
+ *
+ * @param[in] H
+ * @return int
+ */
+int get_heap_size(const struct heap_t * H);
+
+/**
+ * @brief
+ * Plusieurs possibilités de supprimer le tas \p H (voir delete_tree) :
+ * les clés (resp. les données) sont libérées avec freeKey (resp. freeData)
+ * si le paramètre \p deleteKey (resp. \p deleteData) vaut 1.
+ *
+ * @param[in] H
+ * @param[in] deleteKey
+ * @param[in] deleteData
+ */
+void delete_heap(struct heap_t * H, int deleteKey, int deleteData);
+
+/**
+ * @brief
+ * Afficher les éléments du tas \p H dans l'ordre du tableau
+ * (ce n'est pas l'ordre des clés).
+ *
+ * @param[in] H
+ */
+void view_heap(const struct heap_t * H);
+
+/**
+ * @brief
+ * Ajouter dans le tas \p H un élément de clé \p key et de donnée \p data
+ * et restituer sa référence (voir heap_remove_handle).
+ * Le tableau est agrandi (doublé) si nécessaire.
+ *
+ * @param[in] H
+ * @param[in] key
+ * @param[in] data
+ * @return struct heap_handle_t*
+ */
+struct heap_handle_t * heap_insert(struct heap_t * H, void * key, void * data);
+
+/**
+ * @brief
+ * Ajouter dans le tas \p H l'élément \p node, dont la référence a déjà été allouée
+ * dans la réserve du tas (par exemple un élément qui était rangé dans un seau, voir radix_heap_t).
+ * Le numéro d'insertion de \p node est conservé.
+ *
+ * @param[in] H
+ * @param[in] node
+ */
+void heap_insert_node(struct heap_t * H, struct heap_node_t node);
+
+/**
+ * @brief
+ * Restitue l'élément de clé minimum du tas \p H sans le retirer.
+ * Le tas \p H ne doit pas être vide.
+ * NB : le pointeur restitué n'est valide que jusqu'à la prochaine modification du tas.
+ *
+ * @param[in] H
+ * @return struct heap_node_t*
+ */
+struct heap_node_t * heap_min(const struct heap_t * H);
+
+/**
+ * @brief
+ * Retire l'élément de clé minimum du tas \p H et restitue sa donnée.
+ * Si \p key n'est pas NULL, la clé de l'élément retiré y est restituée,
+ * sinon elle est libérée avec freeKey (si freeKey n'est pas NULL).
+ *
+ * @param[in] H
+ * @param[out] key
+ * @return void*
+ */
+void * heap_remove_min(struct heap_t * H, void ** key);
+
+/**
+ * @brief
+ * Retire du tas \p H l'élément dont la clé est égale à \p key
+ * (aucune des deux clés ne précède l'autre) et restitue sa donnée.
+ * La clé de l'élément retiré est libérée avec freeKey (si freeKey n'est pas NULL).
+ * La recherche ne descend pas dans les sous-tas dont la racine est strictement après \p key.
+ * Renvoie NULL si aucun élément ne correspond.
+ *
+ * @param[in] H
+ * @param[in] key
+ * @return void*
+ */
+void * heap_remove(struct heap_t * H, void * key);
+
+/**
+ * @brief
+ * Retire du tas \p H l'élément de référence \p handle (restituée par heap_insert)
+ * et restitue sa donnée : parmi plusieurs clés égales, c'est donc bien cet élément qui est retiré.
+ * L'indice de la référence donne directement sa place, le coût est celui d'un tamisage, O(log n).
+ * La clé est restituée par \p key (voir heap_remove_min).
+ *
+ * @param[in] H
+ * @param[in] handle
+ * @param[out] key
+ * @return void*
+ */
+void * heap_remove_handle(struct heap_t * H, struct heap_handle_t * handle, void ** key);
+
+#endif // _HEAP_H_
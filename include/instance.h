@@ -80,13 +80,38 @@ typedef struct list_t * Instance;
 
 /**
  * @brief
- * Construire une nouvelle instance avec le contenu du fichier \p filename.
+ * Construire une nouvelle instance avec le contenu du fichier \p filename,
+ * qui contient une ligne "id processing_time release_time" par tâche.
+ *
+ * NB : le fichier est projeté en mémoire (mmap) et analysé en une passe, sans conversion par la
+ * bibliothèque standard. Les tâches, suivies de leurs identifiants, sont stockées dans un seul bloc
+ * dont l'instance est propriétaire (voir new_list_from_block) et les nœuds de l'instance forment
+ * un seul tableau. Le bloc est libéré par delete_instance, quelle que soit la valeur de deleteData :
+ * ces tâches ne doivent donc pas être libérées une par une avec delete_task, ni utilisées après
+ * la suppression de l'instance, même si elles en ont été retirées.
  * 
  * @param[in] filename 
  * @return Instance 
  */
 Instance read_instance(const char * filename);
 
+/**
+ * @brief
+ * Construire une nouvelle instance avec le contenu du fichier \p filename (voir read_instance)
+ * en analysant le fichier avec \p num_threads fils d'exécution.
+ *
+ * NB1 : le fichier est découpé en \p num_threads morceaux alignés sur les fins de ligne ; chaque fil
+ * analyse son morceau dans un tableau local, puis les tâches sont recopiées dans l'ordre du fichier.
+ *
+ * NB2 : si \p num_threads <= 0, le nombre de fils est le nombre de processeurs, limité pour que
+ * chaque morceau fasse au moins 1 Mo (read_instance utilise ce choix automatique).
+ * 
+ * @param[in] filename 
+ * @param[in] num_threads 
+ * @return Instance 
+ */
+Instance read_instance_parallel(const char * filename, int num_threads);
+
 /**
  * @brief
  * Afficher les tâches de l'instance \p I.
@@ -100,6 +125,7 @@ void view_instance(Instance I);
  * Liberer la mémoire d'une instance \p I.
  * Si le paramètre \p deleteData vaut 1,
  * les données correspondant aux tâches de l'instance sont aussi supprimer.
+ * Le bloc des tâches d'une instance lue par read_instance est libéré dans les deux cas.
  * 
  * @param[in] I 
  * @param[in] deleteData 
@@ -6,6 +6,8 @@
  * Le fichier définit une liste générique homogène doublement chaînée.
  */
 
+#include <stddef.h>
+
 /**
  * @brief Un noeud d'une liste doublement chaînée contient
  * (+) une donnée (data),
@@ -70,14 +72,20 @@ void set_predecessor(struct list_node_t * node, struct list_node_t * NewPred);
  * (+) une référence (head) sur son premier élément,
  * (+) une référence (tail) sur son dernier élément,
  * (+) le nombre d'éléments,
- * (+) un pointeur de fonction pour afficher ses données, et
- * (+) un pointeur de fonction pour libérer la mémoire de ses données.
+ * (+) un pointeur de fonction pour afficher ses données,
+ * (+) un pointeur de fonction pour libérer la mémoire de ses données, et
+ * (+) pour une liste construite par new_list_from_block : le tableau (node_block, de node_block_size cases)
+ *     de ses nœuds initiaux et le bloc (data_block) de ses données, dont elle est propriétaire
+ *     (NULL et 0 pour une liste construite par new_list).
  */
 struct list_t {
 	struct list_node_t * head, * tail;
 	int numelm;
 	void (*viewData)(const void * data);
 	void (*freeData)(void * data);
+	struct list_node_t * node_block;
+	int node_block_size;
+	void * data_block;
 };
 
 /**
@@ -92,6 +100,24 @@ struct list_t {
  */
 struct list_t * new_list(void (*viewData)(const void *), void (*freeData)(void *));
 
+/**
+ * @brief Construit une liste de \p n éléments dont les données sont, dans l'ordre, les \p n cases
+ * consécutives de \p size octets du bloc \p data_block. Les \p n nœuds sont alloués en un seul tableau.
+ *
+ * NB : la liste devient propriétaire du bloc \p data_block, libéré par delete_list quelle que soit
+ * la valeur de deleteData : ses données ne doivent pas être libérées une par une (freeData vaut NULL),
+ * ni utilisées après la suppression de la liste. Les nœuds du tableau retirés de la liste
+ * restent dans le tableau jusqu'à la suppression de la liste ; les nœuds insérés ensuite sont
+ * alloués un par un, comme pour une liste construite par new_list.
+ * 
+ * @param[in] data_block 
+ * @param[in] size 
+ * @param[in] n 
+ * @param[in] viewData 
+ * @return struct list_t* 
+ */
+struct list_t * new_list_from_block(void * data_block, size_t size, int n, void (*viewData)(const void *));
+
 /**
  * @brief Renvoie 1 si la liste \p L est vide, sinon renvoie 0.
  * 
@@ -171,6 +197,8 @@ void set_tail(struct list_t * L, struct list_node_t * newTail);
  *     alors le pointeur de fonction freeData de la structure list_t
  *     va servir à supprimer les données (data) référencées par
  *     les éléments de la liste \p L.
+ * Le tableau des nœuds et le bloc des données d'une liste construite par new_list_from_block
+ * sont libérés dans les deux cas.
  * 
  * @param[in] L 
  * @param[in] deleteData 
@@ -0,0 +1,94 @@
+#ifndef _POOL_H_
+#define _POOL_H_
+
+/**
+ * @brief
+ * Le fichier définit une réserve (pool) d'emplacements mémoire de taille fixe :
+ * les emplacements sont découpés dans de grands blocs alloués d'un coup,
+ * recyclés grâce à une liste des emplacements libres,
+ * et tous libérés en une seule fois à la suppression de la réserve.
+ */
+
+#include <stddef.h>
+
+/**
+ * @brief Nombre d'emplacements d'un bloc d'une réserve.
+ */
+#define POOL_CHUNK_SIZE 1024
+
+/**
+ * @brief
+ * Un bloc d'une réserve contient
+ * (+) la référence next vers le bloc alloué précédemment, et
+ * (+) ses emplacements, rangés les uns à la suite des autres (slots).
+ */
+struct pool_chunk_t {
+	struct pool_chunk_t * next;
+	max_align_t slots[];
+};
+
+/**
+ * @brief
+ * La réserve est une structure contenant :
+ * (+) la taille (size) d'un emplacement, arrondie pour respecter l'alignement,
+ * (+) la liste (chunks) des blocs alloués, le dernier en tête,
+ * (+) la liste (freelist) des emplacements libérés :
+ *     chaque emplacement libre contient l'adresse de l'emplacement libre suivant,
+ * (+) la position (next) du premier emplacement jamais utilisé du dernier bloc
+ *     et la fin (end) de ce bloc, et
+ * (+) le nombre (numelm) d'emplacements en cours d'utilisation.
+ */
+struct pool_t {
+	size_t size;
+	struct pool_chunk_t * chunks;
+	void * freelist;
+	char * next;
+	char * end;
+	int numelm;
+};
+
+/**
+ * @brief Construire une réserve vide d'emplacements de \p size octets.
+ *
+ * @param[in] size
+ * @return struct pool_t*
+ */
+struct pool_t * new_pool(size_t size);
+
+/**
+ * @brief Restitue le nombre d'emplacements en cours d'utilisation de la réserve \p P.
+ *
+ * @param[in] P
+ * @return int
+ */
+int get_pool_size(const struct pool_t * P);
+
+/**
+ * @brief
+ * Supprimer la réserve \p P ainsi que tous ses blocs :
+ * les emplacements encore utilisés sont libérés eux aussi.
+ *
+ * @param[in] P
+ */
+void delete_pool(struct pool_t * P);
+
+/**
+ * @brief
+ * Restitue un emplacement de la réserve \p P (non initialisé) :
+ * le dernier emplacement libéré s'il y en a un, sinon un emplacement neuf du dernier bloc.
+ * Un nouveau bloc de POOL_CHUNK_SIZE emplacements est alloué si nécessaire.
+ *
+ * @param[in] P
+ * @return void*
+ */
+void * pool_alloc(struct pool_t * P);
+
+/**
+ * @brief Rendre l'emplacement \p ptr, obtenu avec pool_alloc, à la réserve \p P.
+ *
+ * @param[in] P
+ * @param[in] ptr
+ */
+void pool_free(struct pool_t * P, void * ptr);
+
+#endif // _POOL_H_
@@ -0,0 +1,171 @@
+#ifndef _RADIX_HEAP_H_
+#define _RADIX_HEAP_H_
+
+/**
+ * @brief
+ * Le fichier définit un tas radix : une file de priorité monotone
+ * pour des clés dont la date (entier non signé) n'est jamais inférieure
+ * à la date de la dernière clé extraite.
+ */
+
+#include "heap.h"
+
+/**
+ * @brief Nombre de seaux d'un tas radix : un seau par bit d'un unsigned long, plus le seau 0.
+ */
+#define RADIX_HEAP_BUCKETS (8 * sizeof(unsigned long) + 1)
+
+/**
+ * @brief
+ * Un seau d'un tas radix est un tableau non trié contenant
+ * (+) ses éléments (nodes),
+ * (+) le nombre d'éléments (numelm), et
+ * (+) la capacité du tableau (capacity).
+ */
+struct radix_bucket_t {
+	struct heap_node_t * nodes;
+	int numelm;
+	int capacity;
+};
+
+/**
+ * @brief
+ * Le tas radix est une structure contenant :
+ * (+) la date (last) de la dernière clé extraite,
+ * (+) les seaux (buckets) : une clé de date t est dans le seau i>0 si le bit de poids fort
+ *     de (t XOR last) est le bit i-1,
+ * (+) le tas (ties) des clés de date égale à last (le seau 0), ordonnées avec preceed,
+ *     dont la réserve fournit aussi les références des éléments des autres seaux :
+ *     le champ bucket d'une référence est le seau de son élément, et son champ index
+ *     la position de l'élément dans ce seau (ou dans le tas ties pour le seau 0),
+ * (+) le nombre d'éléments (numelm),
+ * (+) le numéro d'insertion (seq) du prochain élément, conservé quand l'élément change de seau,
+ * (+) un pointeur de fonction pour obtenir la date d'une clé,
+ * (+) un pointeur de fonction pour libérer la mémoire de ses clés, et
+ * (+) un pointeur de fonction pour libérer la mémoire de ses données.
+ *
+ * Les clés de même date sont départagées avec le pointeur de fonction preceed du tas ties,
+ * puis les clés égales par leur ordre d'insertion dans le tas radix.
+ */
+struct radix_heap_t {
+	unsigned long last;
+	struct radix_bucket_t buckets[RADIX_HEAP_BUCKETS];
+	struct heap_t * ties;
+	int numelm;
+	unsigned long seq;
+	unsigned long (*time)(const void * key);
+	void (*freeKey)(void * key);
+	void (*freeData)(void * data);
+};
+
+/**
+ * @brief Construire un tas radix vide.
+ *
+ * @param time Pointeur de fonction pour obtenir la date d'une clé.
+ * @param preceed Pointeur de fonction pour comparer deux clés (utilisé entre clés de même date).
+ * @param viewKey Pointeur de fonction pour afficher une clé.
+ * @param viewData Pointeur de fonction pour afficher une donnée.
+ * @param freeKey Pointeur de fonction pour libérer la mémoire d'une clé.
+ * @param freeData Pointeur de fonction pour libérer la mémoire d'une donnée.
+ * @return struct radix_heap_t*
+ */
+struct radix_heap_t * new_radix_heap(unsigned long (*time)(const void *),
+						int (*preceed)(const void *, const void *),
+						void (*viewKey)(const void *), void (*viewData)(const void *),
+						void (*freeKey)(void *), void (*freeData)(void *));
+
+/**
+ * @brief Renvoie 1 si le tas radix \p R est vide, sinon renvoie 0.
+ *
+ * @param[in] R
+ * @return int
+ */
+int radix_heap_is_empty(const struct radix_heap_t * R);
+
+/**
+ * @brief Restitue la taille (nombre d'éléments) du tas radix \p R.
+ *
+ * @param[in] R
+ * @return int
+ */
+int get_radix_heap_size(const struct radix_heap_t * R);
+
+/**
+ * @brief Supprimer le tas radix \p R (voir delete_tree pour \p deleteKey et \p deleteData).
+ *
+ * @param[in] R
+ * @param[in] deleteKey
+ * @param[in] deleteData
+ */
+void delete_radix_heap(struct radix_heap_t * R, int deleteKey, int deleteData);
+
+/**
+ * @brief Afficher les éléments du tas radix \p R (sans ordre particulier).
+ *
+ * @param[in] R
+ */
+void view_radix_heap(const struct radix_heap_t * R);
+
+/**
+ * @brief
+ * Ajouter dans le tas radix \p R un élément de clé \p key et de donnée \p data
+ * et restituer sa référence (voir radix_heap_remove_handle).
+ * La date de \p key ne doit pas être inférieure à la date de la dernière clé extraite.
+ *
+ * @param[in] R
+ * @param[in] key
+ * @param[in] data
+ * @return struct heap_handle_t*
+ */
+struct heap_handle_t * radix_heap_insert(struct radix_heap_t * R, void * key, void * data);
+
+/**
+ * @brief
+ * Restitue l'élément de clé minimum du tas radix \p R sans le retirer.
+ * Le tas \p R ne doit pas être vide.
+ * NB : la recherche du minimum peut redistribuer un seau, d'où le paramètre non constant.
+ *
+ * @param[in] R
+ * @return struct heap_node_t*
+ */
+struct heap_node_t * radix_heap_min(struct radix_heap_t * R);
+
+/**
+ * @brief
+ * Retire l'élément de clé minimum du tas radix \p R et restitue sa donnée.
+ * La clé est restituée par \p key (voir heap_remove_min).
+ *
+ * @param[in] R
+ * @param[out] key
+ * @return void*
+ */
+void * radix_heap_remove_min(struct radix_heap_t * R, void ** key);
+
+/**
+ * @brief
+ * Retire du tas radix \p R l'élément dont la clé est égale à \p key et restitue sa donnée.
+ * Seul le seau de la date de \p key est parcouru.
+ * La clé de l'élément retiré est libérée avec freeKey (si freeKey n'est pas NULL).
+ * Renvoie NULL si aucun élément ne correspond.
+ *
+ * @param[in] R
+ * @param[in] key
+ * @return void*
+ */
+void * radix_heap_remove(struct radix_heap_t * R, void * key);
+
+/**
+ * @brief
+ * Retire du tas radix \p R l'élément de référence \p handle (restituée par radix_heap_insert)
+ * et restitue sa donnée. Dans un seau, l'élément est remplacé par le dernier du seau (O(1)),
+ * dans le tas ties il est retiré avec heap_remove_handle (O(log n)).
+ * La clé est restituée par \p key (voir heap_remove_min).
+ *
+ * @param[in] R
+ * @param[in] handle
+ * @param[out] key
+ * @return void*
+ */
+void * radix_heap_remove_handle(struct radix_heap_t * R, struct heap_handle_t * handle, void ** key);
+
+#endif // _RADIX_HEAP_H_
@@ -1,6 +1,8 @@
 #ifndef _SCHEDULE_H_
 #define _SCHEDULE_H_
 
+#include <stddef.h>
+
 /**
  * @brief 
  * Le fichier définit la structure d'un ordonnancement des tâches.
@@ -8,87 +10,128 @@
 
 /**
  * @brief 
- * Un nœud d'un ordonnancement correspond à l’exécution (partielle ou pas) d'une tâche et contient
- * (+) la tâche à exécuter (task),
- * (+) le début de l’exécution (begin_time), et
- * (+) la fin de l’exécution (end_time).
- * Dans le cas d'un ordonnancement préemptif, une tâche peut se retrouver dans plusieurs nœuds.
- * La somme de (end_time - begin_time) de ces nœuds doit être égal à la durée de cette tâche.
- */
-struct schedule_node_t {
-	struct task_t * task;
-	unsigned long begin_time;
-	unsigned long end_time;
+ * L'ordonnancement d'une machine est stocké par colonnes (struct-of-arrays) : le segment i
+ * correspond à l’exécution (partielle ou pas) d'une tâche et se lit dans
+ * (+) la tâche exécutée (tasks[i]),
+ * (+) le début de l’exécution (begin_times[i]), et
+ * (+) la fin de l’exécution (end_times[i]).
+ * Les trois tableaux ont capacity cases dont les size premières sont utilisées ; ils sont agrandis
+ * (en doublant) lorsqu'ils sont pleins.
+ * Dans le cas d'un ordonnancement préemptif, une tâche peut se retrouver dans plusieurs segments.
+ * La somme de (end_time - begin_time) de ces segments doit être égal à la durée de cette tâche.
+ */
+struct machine_schedule_t {
+	int size;
+	int capacity;
+	struct task_t ** tasks;
+	unsigned long * begin_times;
+	unsigned long * end_times;
 };
 
 /**
- * @brief Restitue la tâche du nœud \p snode.
+ * @brief Restitue le nombre de segments de l'ordonnancement de machine \p MS.
  * 
- * @param[in] snode 
- * @return struct task_t* 
+ * @param[in] MS 
+ * @return int 
  */
-struct task_t * get_schedule_node_task(const struct schedule_node_t * snode);
+int get_machine_schedule_size(const struct machine_schedule_t * MS);
 
 /**
- * @brief Restitue la date de début du nœud \p snode.
+ * @brief Restitue la tâche du segment \p i de l'ordonnancement de machine \p MS.
  * 
- * @param[in] snode 
- * @return unsigned long 
+ * @param[in] MS 
+ * @param[in] i 
+ * @return struct task_t* 
  */
-unsigned long get_schedule_node_begin_time(const struct schedule_node_t * snode);
-
+struct task_t * get_machine_schedule_task(const struct machine_schedule_t * MS, int i);
 
 /**
- * @brief Restitue la date de fin du nœud \p snode.
+ * @brief Restitue la date de début du segment \p i de l'ordonnancement de machine \p MS.
  * 
- * @param[in] snode 
+ * @param[in] MS 
+ * @param[in] i 
  * @return unsigned long 
  */
-unsigned long get_schedule_node_end_time(const struct schedule_node_t * snode);
-
-/**
- * @brief Remplace la date de début du nœud \p snode par \p new_bt.
- * 
- * @param[in] snode 
- * @param new_bt 
- */
-void set_schedule_node_begin_time(struct schedule_node_t * snode, unsigned long new_bt);
+unsigned long get_machine_schedule_begin_time(const struct machine_schedule_t * MS, int i);
 
 /**
- * @brief Remplace la date de fin du nœud \p snode par \p new_bt.
+ * @brief Restitue la date de fin du segment \p i de l'ordonnancement de machine \p MS.
  * 
- * @param[in] snode 
- * @param new_et 
- */
-void set_schedule_node_end_time(struct schedule_node_t * snode, unsigned long new_et);
-
-/**
- * @brief Afficher les caractéristiques du nœud d'ordonnancement \p snode.
- * 
- * @param[in] snode 
- */
-void view_schedule_node(const void * snode);
-
-/**
- * @brief Supprimer et libérer la mémoire du nœud d'ordonnancement \p snode.
- * Attention ! la mémoire de l'attribut task du nœud \p snode ne doit pas être libérée. 
- * 
- * @param[in] snode 
+ * @param[in] MS 
+ * @param[in] i 
+ * @return unsigned long 
  */
-void delete_schedule_node(void * snode);
+unsigned long get_machine_schedule_end_time(const struct machine_schedule_t * MS, int i);
 
 /**
  * @brief 
  * Un ordonnancement est
- * (+) un tableau de listes (schedule) chacune correspondant à ordonnancement d'une machine, et
- * (+) le nombre de machines de l'ordonnancement (num_machines).
+ * (+) un tableau (schedule) des ordonnancements de chaque machine,
+ * (+) le nombre de machines de l'ordonnancement (num_machines),
+ * (+) un arbre tournoi (end_times) des dates de fin des machines, stocké dans un tableau
+ *     de 2*num_leaves cases : la feuille de la machine i est la case num_leaves+i et contient
+ *     le end_time du dernier segment de la machine (0 si elle n'a pas de tâche), les feuilles
+ *     sans machine contiennent ULONG_MAX, et la case k (1 <= k < num_leaves) contient
+ *     le minimum des cases 2k et 2k+1 (la case 0 n'est pas utilisée),
+ * (+) l'arbre tournoi symétrique (latest_end_times) où chaque case interne contient le maximum
+ *     de ses deux fils (les feuilles sans machine y contiennent 0), et
+ * (+) les agrégats des métriques de l'ordonnancement : le nombre de tâches ordonnancées (num_tasks),
+ *     la somme de leurs dates de fin (total_completion_time), la somme de leurs temps de séjour
+ *     (total_flow_time, date de fin - date de libération) et la somme des durées des segments (busy_time).
+ * (+) pour un ordonnancement chargé par load_schedule : la projection du fichier (mapping, de taille
+ *     mapping_size), les tâches reconstruites (loaded_tasks) et la colonne des tâches de tous les
+ *     segments (loaded_segment_tasks) ; mapping vaut NULL pour un ordonnancement construit par new_schedule.
+ * (+) la fonction (sink) qui reçoit les segments terminés et son argument (sink_arg), NULL si
+ *     l'ordonnancement garde tous ses segments (voir set_schedule_sink).
  * 
- * NB : l'ordonnancement de chaque machine est une liste qui contient l'enchaînement d’exécution
- * de tâches dans l'ordre croissant par rapport à leur date de début (begin_time dans schedule_node_t).
+ * NB1 : les segments de l'ordonnancement de chaque machine sont rangés dans l'ordre croissant
+ * par rapport à leur date de début (begin_times dans machine_schedule_t).
+ *
+ * NB2 : les arbres tournoi et les agrégats sont tenus à jour par add_task_to_schedule et preempt_task
+ * (les seules fonctions qui modifient la fin d'une machine), en O(log num_machines).
+ *
+ * NB3 : une tâche est comptée dans les agrégats dès que son dernier segment est ajouté : si elle est
+ * interrompue ensuite, preempt_task la retire, et elle est comptée de nouveau quand la suite
+ * de son exécution est ajoutée.
  */
 struct schedule_t {
-    struct list_t ** schedule;
+    struct machine_schedule_t * schedule;
     int num_machines;
+    unsigned long * end_times;
+    unsigned long * latest_end_times;
+    int num_leaves;
+    int num_tasks;
+    unsigned long total_completion_time;
+    unsigned long total_flow_time;
+    unsigned long busy_time;
+    void * mapping;
+    size_t mapping_size;
+    struct task_t * loaded_tasks;
+    struct task_t ** loaded_segment_tasks;
+    void (*sink)(void * arg, int machine, const struct task_t * task, unsigned long bt, unsigned long et);
+    void * sink_arg;
+};
+
+/**
+ * @brief 
+ * Les métriques d'un ordonnancement :
+ * (+) le nombre de tâches ordonnancées (num_tasks),
+ * (+) le "makespan" (makespan),
+ * (+) la somme des dates de fin des tâches (total_completion_time),
+ * (+) la somme et la moyenne des temps de séjour des tâches (total_flow_time, mean_flow_time),
+ * (+) le temps pendant lequel les machines exécutent une tâche (busy_time),
+ * (+) le temps d'inactivité des machines avant le makespan (idle_time = num_machines * makespan - busy_time), et
+ * (+) le taux d'utilisation des machines (utilization = busy_time / (num_machines * makespan)).
+ */
+struct schedule_metrics_t {
+    int num_tasks;
+    unsigned long makespan;
+    unsigned long total_completion_time;
+    unsigned long total_flow_time;
+    double mean_flow_time;
+    unsigned long busy_time;
+    unsigned long idle_time;
+    double utilization;
 };
 
 /**
@@ -104,9 +147,9 @@ struct schedule_t * new_schedule(int num_m);
  * 
  * @param[in] S 
  * @param[in] machine 
- * @return struct list_t* 
+ * @return struct machine_schedule_t* 
  */
-struct list_t * get_schedule_of_machine(const struct schedule_t * S, const int machine);
+struct machine_schedule_t * get_schedule_of_machine(const struct schedule_t * S, const int machine);
 
 /**
  * @brief Restitue le nombre de machines de l'ordonnancement \p S.
@@ -138,18 +181,152 @@ void delete_schedule(struct schedule_t * S);
  */
 void save_schedule(struct schedule_t * S, char * filename);
 
+/**
+ * @brief Enregistre l'ordonnancement \p S au fichier binaire \p filename.
+ * Le fichier est une suite de mots unsigned long (ordre des octets de la machine) :
+ * (+) l'en-tête : la signature "SCHEDBIN", la version, num_machines, le nombre de tâches distinctes,
+ *     la taille de la table des identifiants et les agrégats des métriques de \p S,
+ * (+) pour chaque machine, son nombre de segments et la position de ses colonnes dans le fichier,
+ * (+) pour chaque tâche, la position de son identifiant dans la table des identifiants,
+ *     sa durée et sa date de libération,
+ * (+) la table des identifiants (chaînes terminées par '\0', complétée jusqu'à un multiple de 8 octets), et
+ * (+) pour chaque machine, les colonnes begin_times, end_times et l'indice de la tâche de chaque segment.
+ * 
+ * @param[in] S 
+ * @param[in] filename 
+ */
+void save_schedule_binary(struct schedule_t * S, char * filename);
+
+/**
+ * @brief Charger l'ordonnancement enregistré par save_schedule_binary dans le fichier \p filename.
+ * Le fichier est projeté en mémoire (mmap) en lecture seule : les colonnes begin_times et end_times
+ * des machines pointent directement dans la projection, sans analyse du contenu ; seules les tâches
+ * et la colonne des tâches sont reconstruites.
+ *
+ * NB : l'ordonnancement restitué ne peut pas être modifié (add_task_to_schedule et preempt_task
+ * s'arrêtent en erreur) ; il doit être libéré avec delete_schedule.
+ * 
+ * @param[in] filename 
+ * @return struct schedule_t* 
+ */
+struct schedule_t * load_schedule(const char * filename);
+
+/**
+ * @brief Faire de l'ordonnancement \p S un ordonnancement en flux : chaque segment qui ne peut plus
+ * être modifié est passé à la fonction \p sink (avec l'argument \p arg) puis retiré de \p S.
+ *
+ * NB1 : seul le dernier segment d'une machine peut être modifié (par preempt_task), et un segment
+ * n'est plus le dernier dès que add_task_to_schedule en ajoute un autre après lui sur sa machine ;
+ * S garde donc au plus deux segments par machine, et chaque machine transmet ses segments dans
+ * l'ordre de leurs dates de début.
+ *
+ * NB2 : les arbres tournoi et les métriques restent ceux de tout l'ordonnancement ; flush_schedule doit
+ * être appelée à la fin de la simulation pour transmettre les segments restants.
+ *
+ * @param[in] S 
+ * @param[in] sink 
+ * @param[in] arg 
+ */
+void set_schedule_sink(struct schedule_t * S,
+						void (*sink)(void * arg, int machine, const struct task_t * task, unsigned long bt, unsigned long et),
+						void * arg);
+
+/**
+ * @brief Transmettre à la fonction de flux de l'ordonnancement \p S tous les segments qu'il contient encore,
+ * puis les retirer de \p S (sans effet si \p S n'est pas en flux).
+ *
+ * @param[in] S 
+ */
+void flush_schedule(struct schedule_t * S);
+
+struct output_buffer_t;
+struct saved_schedule_writer_t;
+
+/**
+ * @brief Construire un écrivain en flux de segments vers le fichier \p filename
+ * (vers la sortie standard, par exemple un tube, si \p filename est NULL).
+ * Chaque segment est écrit sur une ligne "machine id begin_time end_time", dans l'ordre où il arrive
+ * (machines mêlées) ; le tampon de SAVE_BUFFER_SIZE octets est écrit dès qu'il est plein.
+ * La mémoire de l'écrivain ne dépend pas de la taille de l'ordonnancement.
+ * 
+ * @param[in] filename 
+ * @return struct output_buffer_t* 
+ */
+struct output_buffer_t * new_schedule_writer(const char * filename);
+
+/**
+ * @brief Fonction de flux (voir set_schedule_sink) qui écrit avec l'écrivain \p writer la ligne
+ * "machine id begin_time end_time" du segment.
+ * 
+ * @param[in] writer 
+ * @param[in] machine 
+ * @param[in] task 
+ * @param[in] bt 
+ * @param[in] et 
+ */
+void write_schedule_segment(void * writer, int machine, const struct task_t * task, unsigned long bt, unsigned long et);
+
+/**
+ * @brief Écrire les données en attente de l'écrivain \p W, fermer son fichier et libérer sa mémoire.
+ * 
+ * @param[in] W 
+ */
+void delete_schedule_writer(struct output_buffer_t * W);
+
+/**
+ * @brief Construire un écrivain tamponné de segments vers le fichier \p filename (vers la sortie standard
+ * si \p filename est NULL) pour un ordonnancement de \p num_machines machines.
+ * Le fichier écrit est identique à celui de save_schedule : le nombre de machines, puis les lignes
+ * "id begin_time end_time" des segments, machine par machine. Il n'est écrit qu'à la destruction
+ * de l'écrivain (voir new_schedule_writer pour une sortie au fil de la simulation).
+ *
+ * NB : les segments arrivent dans l'ordre de la simulation, machines mêlées. Chaque machine les accumule
+ * dans un bloc de max(WRITER_MIN_BLOCK_SIZE, SAVE_BUFFER_SIZE / num_machines) octets ; un bloc plein
+ * est écrit dans un fichier temporaire et l'écrivain ne garde que sa machine. delete_saved_schedule_writer
+ * recopie les blocs dans l'ordre des machines. La mémoire de l'écrivain est donc en O(num_machines)
+ * blocs, plus un entier par bloc écrit dans le fichier temporaire.
+ * 
+ * @param[in] filename 
+ * @param[in] num_machines 
+ * @return struct saved_schedule_writer_t* 
+ */
+struct saved_schedule_writer_t * new_saved_schedule_writer(const char * filename, int num_machines);
+
+/**
+ * @brief Fonction de flux (voir set_schedule_sink) qui confie à l'écrivain \p writer la ligne
+ * "id begin_time end_time" du segment, à écrire avec les segments de la machine \p machine.
+ * Les segments d'une machine doivent arriver dans l'ordre de leurs dates de début.
+ * 
+ * @param[in] writer 
+ * @param[in] machine 
+ * @param[in] task 
+ * @param[in] bt 
+ * @param[in] et 
+ */
+void write_saved_schedule_segment(void * writer, int machine, const struct task_t * task, unsigned long bt, unsigned long et);
+
+/**
+ * @brief Écrire le fichier de l'écrivain \p W (l'en-tête puis les segments de chaque machine),
+ * le fermer et libérer la mémoire et le fichier temporaire de l'écrivain.
+ * 
+ * @param[in] W 
+ */
+void delete_saved_schedule_writer(struct saved_schedule_writer_t * W);
+
 /**
  * @brief Restitue la première machine de l'ordonnancement \p S qui est disponible au moment \p time.
  * Si aucune machine n'est disponible en \p time, la valeur retournée est -1.
  *
- * NB1 : Il faut chercher les machines de façon itérative en commençant par la première.
- * La machine disponible avec le plus petit indice doit être restituée.
+ * NB1 : La machine disponible avec le plus petit indice est restituée. Elle est trouvée sans parcourir
+ * les machines : la recherche descend l'arbre tournoi end_times de la racine vers la feuille la plus
+ * à gauche dont la date de fin convient, en allant à gauche dès que le fils gauche contient une machine
+ * disponible. Elle coûte O(log num_machines).
  * 
  * NB2 : Afin de décider si une machine est disponible au moment \p time, il suffit de comparer \p time
- * avec le end_time du dernier nœud de cette machine (il n'y a pas besoin de parcourir tous les nœuds).
+ * avec le end_time du dernier segment de cette machine (il n'y a pas besoin de parcourir tous les segments).
  * 
- * NB3 : Une machine n'est pas considérée comme disponible au moment \p time si il y a une tâche qui
- * termine son exécution en ce moment (c'est-à-dire, si end_time=time).
+ * NB3 : Une machine est considérée comme disponible au moment \p time si sa dernière tâche
+ * termine son exécution en ce moment (c'est-à-dire, si end_time=time) : la condition est end_time <= time.
  *
  * @param[in] S 
  * @param[in] time 
@@ -161,13 +338,17 @@ int find_empty_machine(struct schedule_t * S, unsigned long time);
  * @brief Restitue la première machine de l'ordonnancement \p S qui peut être interrompue au moment \p time.
  * Si aucune machine ne peut pas être interrompue en \p time, la valeur retournée est -1.
  *
- * NB1 : Il faut chercher les machines de façon itérative en commençant par la première.
- * La machine à interrompre avec le plus petit indice doit être restituée.
+ * NB1 : La machine restituée est celle dont la tâche en cours d'exécution finit le plus tard
+ * (en cas d'égalité, celle avec le plus petit indice) : c'est la racine de l'arbre latest_end_times,
+ * la recherche coûte donc O(log num_machines).
  *
  * NB2 : Afin de décider si une machine est susceptible à être interrompue au moment \p time,
  * il suffit de comparer le temps d’exécution \p processing_time de la tâche qu'on veut commencer
- * avec le temps restant ( \p time - begin_time ) de la tâche qui est en train d’exécuter
- * (dernier nœud de cette machine, il n'y a pas besoin de parcourir tous les nœuds).
+ * avec le temps restant ( end_time - \p time ) de la tâche qui est en train d’exécuter
+ * (dernier segment de cette machine, il n'y a pas besoin de parcourir tous les segments) :
+ * la machine est interrompue seulement si le temps restant est strictement plus grand.
+ *
+ * NB3 : \p time peut valoir 0 (tâches libérées en 0 alors que toutes les machines sont occupées).
  * 
  * @param[in] S 
  * @param[in] time 
@@ -194,7 +375,9 @@ void add_task_to_schedule(struct schedule_t * S, struct task_t * task,
 
 /**
  * @brief Mettre à jour la date de fin (end_time) de la dernière tâche de la machine \p machine
- * de l'ordonnancement \p S avec la valeur \p new_et.
+ * de l'ordonnancement \p S avec la valeur \p new_et, et restituer l'ancienne date de fin.
+ * La date de début (begin_time) de la tâche ne change pas ; si \p new_et ne dépasse pas cette date,
+ * la tâche n'a pas encore été exécutée et son segment est retiré de l'ordonnancement.
  * 
  * @param[in] S 
  * @param[in] machine 
@@ -206,10 +389,20 @@ unsigned long preempt_task(struct schedule_t * S, int machine, unsigned long new
 /**
  * @brief Calculer et renvoyer la valeur de l'objectif "makespan" de l'ordonnancement \p S.
  * Le "makespan" est la date de fin de la dernière tâche de l'ordonnancement.
+ * Il est lu à la racine de l'arbre latest_end_times, en O(1).
  * 
  * @param[in] S 
  * @return unsigned long 
  */
 unsigned long get_makespan(struct schedule_t * S);
 
+/**
+ * @brief Restitue les métriques de l'ordonnancement \p S, calculées en O(1) à partir des agrégats
+ * tenus à jour par add_task_to_schedule et preempt_task (elles peuvent donc être lues en cours de simulation).
+ * 
+ * @param[in] S 
+ * @return struct schedule_metrics_t 
+ */
+struct schedule_metrics_t get_schedule_metrics(const struct schedule_t * S);
+
 #endif // _SCHEDULE_H_
@@ -6,6 +6,15 @@
  * Le fichier définit un arbre binaire de recherche générique équilibré ou non-équilibré.
  */
 
+#include "pool.h"
+
+/**
+ * @brief Les valeurs possibles de balanced pour new_tree et new_tree_by_value.
+ */
+#define TREE_BST 0	// arbre binaire de recherche non-équilibré
+#define TREE_AVL 1	// arbre AVL
+#define TREE_RED_BLACK 2	// arbre rouge-noir
+
 /**
  * @brief
  * Un élément d'un arbre binaire de recherche contient
@@ -14,15 +23,26 @@
  * (+) le facteur d'équilibre (bfactor) :
  *     différence entre la hauteur du fils gauche et la hauteur du fils droit
  *     NB : le facteur d'équilibre d'une feuille est égal à 0,
- * (+) la référence left vers le fils gauche, et
- * (+) la référence right vers le fils droit.
+ *     il n'est mis à jour que si l'arbre est un arbre AVL ;
+ *     dans un arbre rouge-noir, bfactor contient la couleur du nœud (1 pour rouge, 0 pour noir),
+ * (+) le nombre (size) de nœuds et la somme (sum) des poids des clés du sous-arbre raciné au nœud,
+ *     mis à jour seulement si l'arbre est augmenté (voir tree_augment),
+ * (+) la référence left vers le fils gauche,
+ * (+) la référence right vers le fils droit,
+ * (+) la référence parent vers le père (NULL pour la racine), et
+ * (+) la copie (keyval) de la clé si l'arbre stocke ses clés par valeur (voir new_tree_by_value) :
+ *     key pointe alors sur keyval, à côté des autres champs du nœud.
  */
 struct tree_node_t {
 	void * key;
 	void * data;
 	int bfactor;
+	int size;
+	unsigned long sum;
 	struct tree_node_t * left;
 	struct tree_node_t * right;
+	struct tree_node_t * parent;
+	unsigned long keyval[];
 };
 
 /**
@@ -65,6 +85,14 @@ struct tree_node_t * get_left(const struct tree_node_t * node);
  */
 struct tree_node_t * get_right(const struct tree_node_t * node);
 
+/**
+ * @brief Restitue le père du nœud \p node (NULL si \p node est la racine).
+ * 
+ * @param[in] node 
+ * @return tree_node_t* 
+ */
+struct tree_node_t * get_parent(const struct tree_node_t * node);
+
 /**
  * @brief Restitue le facteur d'équilibre du nœud \p node.
  * 
@@ -132,17 +160,26 @@ void set_bfactor(struct tree_node_t * node, int newBFactor);
 /**
  * L'arbre binaire de recherche est une structure contenant :
  * (+) une référence (root) sur sa racine,
+ * (+) des références (leftmost et rightmost) sur ses nœuds de clé minimum et maximum,
+ *     mises à jour à chaque insertion et suppression,
  * (+) le nombre d'éléments,
  * (+) un pointeur de fonction pour comparer ses clés,
  * (+) un pointeur de fonction pour afficher ses clés,
  * (+) un pointeur de fonction pour afficher ses données,
  * (+) un pointeur de fonction pour libérer la mémoire de ses clés,
- * (+) un pointeur de fonction pour libérer la mémoire de ses données, et
- * (+) une indication (balanced) si l'arbre binaire de recherche
- *     est équilibré (balanced=1) ou pas (balanced=0).
+ * (+) un pointeur de fonction pour libérer la mémoire de ses données,
+ * (+) le mode d'équilibrage (balanced) de l'arbre binaire de recherche :
+ *     TREE_BST (non-équilibré), TREE_AVL ou TREE_RED_BLACK,
+ * (+) la taille (keySize) des clés stockées par valeur dans les nœuds,
+ *     0 si les nœuds ne stockent que l'adresse des clés,
+ * (+) l'indication (augmented) que les champs size et sum des nœuds sont tenus à jour,
+ *     et le pointeur de fonction (weight) qui donne le poids d'une clé (NULL : poids nul), et
+ * (+) la réserve (pool) dans laquelle sont alloués ses nœuds.
  */
 struct tree_t {
 	struct tree_node_t * root;
+	struct tree_node_t * leftmost;
+	struct tree_node_t * rightmost;
 	int numelm;
 	int (*preceed)(const void * a, const void * b);
 	void (*viewKey)(const void * key);
@@ -150,12 +187,17 @@ struct tree_t {
 	void (*freeKey)(void * key);
 	void (*freeData)(void * data);
 	int balanced;
+	size_t keySize;
+	int augmented;
+	unsigned long (*weight)(const void * key);
+	struct pool_t * pool;
 };
 
 /**
  * @brief Construire un arbre binaire de recherche vide.
  * 
- * @param balanced Indique si l'arbre doit être équilibré (valeur 1) ou pas (valeur 0).
+ * @param balanced Indique si l'arbre est non-équilibré (TREE_BST), un arbre AVL (TREE_AVL)
+ *                 ou un arbre rouge-noir (TREE_RED_BLACK).
  * @param preceed Pointeur de fonction pour comparer deux clés de l'arbre.
  * @param viewKey Pointeur de fonction pour afficher la clé d'un nœud de l'arbre.
  * @param viewData Pointeur de fonction pour afficher la donnée d'un nœud de l'arbre.
@@ -167,6 +209,27 @@ struct tree_t * new_tree(int balanced, int (*preceed)(const void *, const void *
 						void (*viewKey)(const void *), void (*viewData)(const void *),
 						void (*freeKey)(void *), void (*freeData)(void *));
 
+/**
+ * @brief
+ * Construire un arbre binaire de recherche vide dont les clés, de \p keySize octets,
+ * sont stockées par valeur dans les nœuds : tree_insert copie la clé dans le nouveau nœud,
+ * l'appelant garde donc la propriété de la clé qu'il passe (qui peut être une variable locale).
+ * Les comparaisons lisent la clé dans le nœud lui-même, sans accès à une autre zone mémoire.
+ * Les clés disparaissent avec leurs nœuds : il n'y a pas de pointeur de fonction freeKey.
+ * 
+ * @param balanced Indique si l'arbre est non-équilibré (TREE_BST), un arbre AVL (TREE_AVL)
+ *                 ou un arbre rouge-noir (TREE_RED_BLACK).
+ * @param keySize Taille en octets d'une clé.
+ * @param preceed Pointeur de fonction pour comparer deux clés de l'arbre.
+ * @param viewKey Pointeur de fonction pour afficher la clé d'un nœud de l'arbre.
+ * @param viewData Pointeur de fonction pour afficher la donnée d'un nœud de l'arbre.
+ * @param freeData Pointeur de fonction pour libérer la mémoire de la donnée d'un nœud de l'arbre.
+ * @return struct tree_t* 
+ */
+struct tree_t * new_tree_by_value(int balanced, size_t keySize, int (*preceed)(const void *, const void *),
+						void (*viewKey)(const void *), void (*viewData)(const void *),
+						void (*freeData)(void *));
+
 /**
  * @brief Renvoie 1 si l'arbre \p T est vide, sinon renvoie 0.
  * 
@@ -176,7 +239,7 @@ struct tree_t * new_tree(int balanced, int (*preceed)(const void *, const void *
 int tree_is_empty(struct tree_t * T);
 
 /**
- * @brief Renvoie 1 si l'arbre \p T est équilibré, sinon renvoie 0.
+ * @brief Renvoie le mode d'équilibrage de l'arbre \p T : 0 (TREE_BST) s'il n'est pas équilibré.
  * 
  * @param[in] T 
  * @return int 
@@ -221,6 +284,22 @@ void decrease_tree_size(struct tree_t * T);
  */
 void set_root(struct tree_t * T, struct tree_node_t * newRoot);
 
+/**
+ * @brief Restitue le nœud de clé minimum de l'arbre \p T (NULL si l'arbre est vide), en temps constant.
+ * 
+ * @param[in] T 
+ * @return tree_node_t* 
+ */
+struct tree_node_t * get_tree_min_node(const struct tree_t * T);
+
+/**
+ * @brief Restitue le nœud de clé maximum de l'arbre \p T (NULL si l'arbre est vide), en temps constant.
+ * 
+ * @param[in] T 
+ * @return tree_node_t* 
+ */
+struct tree_node_t * get_tree_max_node(const struct tree_t * T);
+
 /**
  * @brief
  * Plusieurs possibilités de supprimer l'arbre binaire de recherche T :
@@ -237,6 +316,8 @@ void set_root(struct tree_t * T, struct tree_node_t * newRoot);
  *     Alors le pointeur de fonction freeData de la structure BinarySearchTree
  *     va servir à supprimer les données (data) référencées par
  *     les éléments de l'arbre T.
+ *
+ * Les nœuds sont libérés en une seule fois avec la réserve de l'arbre.
  * 
  * @param[in] T 
  * @param[in] deleteKey 
@@ -260,17 +341,23 @@ void view_tree(const struct tree_t * T);
 /**
  * @brief
  * Ajouter dans l'arbre binaire de recherche \p T un élément de clé \p key et de donnée \p data.
+ * Si l'arbre stocke ses clés par valeur, c'est une copie de \p key qui est ajoutée.
+ * Un élément de clé égale à celle d'éléments déjà présents est placé après eux dans l'ordre infixe.
+ * Le nœud créé est restitué : il reste associé à cet élément tant que l'élément est dans l'arbre
+ * (les rotations et les suppressions d'autres éléments ne déplacent pas les clés et les données
+ * d'un nœud à l'autre), il peut donc servir de référence (handle) pour tree_remove_node.
  * 
  * @param[in] T 
  * @param[in] key 
  * @param[in] data 
+ * @return struct tree_node_t* 
  */
-void tree_insert(struct tree_t * T, void * key, void * data);
+struct tree_node_t * tree_insert(struct tree_t * T, void * key, void * data);
 
 /**
  * @brief
  * Trouver et renvoyer le nœud de clé minimum du sous-arbre raciné au nœud \p curr.
- * NB : fonction récursive.
+ * NB : fonction itérative.
  * 
  * @param[in] curr 
  * @return struct tree_node_t* 
@@ -280,7 +367,7 @@ struct tree_node_t * tree_min(struct tree_node_t * curr);
 /**
  * @brief
  * Trouver et renvoyer le nœud de clé maximum du sous-arbre raciné au nœud \p curr.
- * NB : fonction récursive.
+ * NB : fonction itérative.
  * 
  * @param[in] curr 
  * @return struct tree_node_t* 
@@ -290,9 +377,10 @@ struct tree_node_t * tree_max(struct tree_node_t * curr);
 /**
  * @brief 
  * Chercher dans le sous-arbre raciné au nœud \p curr et renvoyer le nœud avec clé \p key.
+ * Si plusieurs nœuds ont une clé égale à \p key, le premier dans l'ordre infixe est renvoyé.
  * Le pointeur de fonction \p preceed donne l'ordre entre deux clés.
- * NB1 : fonction récursive.
- * NB2 : on fait l'hypothèse que la clé \p key existe dans le sous-arbre raciné au nœud \p curr.
+ * NB1 : fonction itérative.
+ * NB2 : renvoie NULL si la clé \p key n'existe pas dans le sous-arbre raciné au nœud \p curr.
  * 
  * @param[in] curr 
  * @param[in] key 
@@ -306,8 +394,8 @@ struct tree_node_t * tree_find_node(struct tree_node_t * curr, void * key, int (
  * Chercher dans le sous-arbre raciné au nœud \p curr et renvoyer le prédécesseur du nœud avec clé \p key.
  * Le prédécesseur est le nœud qui contient la clé la plus grande qui est plus petite que la clé \p key.
  * Le pointeur de fonction \p preceed donne l'ordre entre deux clés.
- * NB1 : fonction récursive.
- * NB2 : on fait l'hypothèse que la clé \p key existe dans le sous-arbre raciné au nœud \p curr.
+ * NB1 : fonction itérative.
+ * NB2 : renvoie NULL s'il n'existe pas de tel nœud.
  * 
  * @param[in] curr 
  * @param[in] key 
@@ -321,8 +409,8 @@ struct tree_node_t * tree_find_predecessor(struct tree_node_t * curr, void * key
  * Chercher dans le sous-arbre raciné au nœud \p curr et renvoyer le successeur du nœud avec clé \p key.
  * Le successeur est le nœud qui contient la clé la plus petite qui est plus grande que la clé \p key.
  * Le pointeur de fonction \p preceed donne l'ordre entre deux clés.
- * NB1 : fonction récursive.
- * NB2 : on fait l'hypothèse que la clé \p key existe dans le sous-arbre raciné au nœud \p curr.
+ * NB1 : fonction itérative.
+ * NB2 : renvoie NULL s'il n'existe pas de tel nœud.
  * 
  * @param[in] curr 
  * @param[in] key 
@@ -335,7 +423,11 @@ struct tree_node_t * tree_find_successor(struct tree_node_t * curr, void * key,
  * @brief 
  * Supprime le nœud avec clé \p key de l'arbre \p T et restitue sa donnée.
  * La clé \p key existe obligatoirement dans l'arbre \p T.
- * La mémoire du nœud supprimé ainsi que de sa clé est libérée mais pas la mémoire de la donnée.
+ * Si plusieurs nœuds ont une clé égale à \p key, c'est le premier dans l'ordre infixe qui est supprimé.
+ * La mémoire du nœud supprimé est libérée mais pas la mémoire de sa clé (sauf si elle est stockée par valeur)
+ * ni celle de la donnée.
+ * NB : si l'arbre stocke ses clés par valeur, \p key peut être la clé d'un nœud de l'arbre
+ * (par exemple celle de tree_min), mais elle ne doit plus être lue après l'appel.
  * 
  * @param[in] T 
  * @param[in] key 
@@ -343,4 +435,162 @@ struct tree_node_t * tree_find_successor(struct tree_node_t * curr, void * key,
  */
 void * tree_remove(struct tree_t * T, void * key);
 
+/**
+ * @brief 
+ * Supprime de l'arbre \p T le nœud \p node (restitué par tree_insert) et restitue sa donnée,
+ * sans recherche de clé : c'est bien cet élément qui est supprimé, même si d'autres ont une clé égale.
+ * La mémoire libérée est la même qu'avec tree_remove.
+ * 
+ * @param[in] T 
+ * @param[in] node 
+ * @return void* 
+ */
+void * tree_remove_node(struct tree_t * T, struct tree_node_t * node);
+
+/**
+ * @brief 
+ * Supprime le nœud de clé minimum de l'arbre \p T et restitue sa donnée, sans rechercher sa clé.
+ * L'arbre \p T ne doit pas être vide.
+ * La clé est restituée par \p key (voir heap_remove_min) ; si l'arbre stocke ses clés par valeur,
+ * la clé disparaît avec le nœud et \p key reçoit NULL
+ * (la clé se lit avant la suppression avec get_tree_min_node).
+ * 
+ * @param[in] T 
+ * @param[out] key 
+ * @return void* 
+ */
+void * tree_pop_min(struct tree_t * T, void ** key);
+
+/**
+ * @brief
+ * Restitue le premier nœud de l'arbre \p T dans l'ordre infixe (NULL si l'arbre est vide), en temps constant.
+ * Avec tree_iter_next, il permet de parcourir les éléments dans l'ordre croissant des clés
+ * sans récursion, sans pile et sans allocation :
+ *     for (node = tree_iter_begin(T); node != NULL; node = tree_iter_next(node)) { ... }
+ * L'arbre ne doit pas être modifié pendant le parcours.
+ * 
+ * @param[in] T 
+ * @return struct tree_node_t* 
+ */
+struct tree_node_t * tree_iter_begin(const struct tree_t * T);
+
+/**
+ * @brief
+ * Restitue le premier nœud de l'arbre \p T, dans l'ordre infixe, dont la clé est supérieure ou égale à \p key
+ * (NULL s'il n'y en a pas), en O(log n) si l'arbre est équilibré : c'est le point de départ d'un parcours
+ * avec tree_iter_next à partir d'une clé donnée.
+ * 
+ * @param[in] T 
+ * @param[in] key 
+ * @return struct tree_node_t* 
+ */
+struct tree_node_t * tree_iter_begin_at(const struct tree_t * T, const void * key);
+
+/**
+ * @brief
+ * Restitue le nœud qui suit le nœud \p node dans l'ordre infixe (NULL si \p node est le dernier).
+ * Les références parent remplacent la pile : le parcours complet d'un arbre de n nœuds coûte O(n).
+ * 
+ * @param[in] node 
+ * @return struct tree_node_t* 
+ */
+struct tree_node_t * tree_iter_next(const struct tree_node_t * node);
+
+/**
+ * @brief
+ * Appeler \p callback(key, data, arg) sur chaque élément de l'arbre \p T dont la clé est comprise
+ * entre \p lo et \p hi (bornes incluses), dans l'ordre croissant des clés, et restituer le nombre d'appels.
+ * Une borne NULL n'est pas prise en compte (lo = NULL : depuis le minimum, hi = NULL : jusqu'au maximum).
+ * Le parcours s'arrête dès que \p callback renvoie 0 : les k plus petits éléments
+ * s'obtiennent par exemple avec lo = hi = NULL et un callback qui compte jusqu'à k.
+ * Coût : O(log n + k) pour k éléments visités si l'arbre est équilibré, sans récursion ni allocation.
+ * L'arbre ne doit pas être modifié par \p callback.
+ * 
+ * @param[in] T 
+ * @param[in] lo 
+ * @param[in] hi 
+ * @param[in] callback 
+ * @param[in] arg 
+ * @return int 
+ */
+int tree_range(const struct tree_t * T, const void * lo, const void * hi,
+				int (*callback)(void * key, void * data, void * arg), void * arg);
+
+/**
+ * @brief
+ * Augmenter l'arbre vide \p T : chaque nœud tient à jour le nombre de nœuds (size) de son sous-arbre
+ * et la somme (sum) des poids \p weight(key) de ses clés (\p weight peut valoir NULL si seules
+ * les tailles sont utiles). Les champs sont mis à jour par les insertions, les suppressions,
+ * les rotations et tree_build_from_sorted, ce qui ajoute une remontée jusqu'à la racine
+ * à chaque insertion et à chaque suppression ; en échange, tree_select, tree_rank et tree_prefix_sum
+ * répondent en O(log n) si l'arbre est équilibré.
+ * 
+ * @param[in] T 
+ * @param[in] weight 
+ */
+void tree_augment(struct tree_t * T, unsigned long (*weight)(const void *));
+
+/**
+ * @brief
+ * Restitue le nœud de rang \p k (de 0 à get_tree_size(T)-1) de l'arbre augmenté \p T,
+ * c'est-à-dire le (k+1)-ième nœud dans l'ordre infixe. Par exemple, la médiane est de rang n/2,
+ * le 99e centile est de rang (99*n)/100.
+ * 
+ * @param[in] T 
+ * @param[in] k 
+ * @return struct tree_node_t* 
+ */
+struct tree_node_t * tree_select(const struct tree_t * T, int k);
+
+/**
+ * @brief
+ * Restitue le nombre d'éléments de l'arbre augmenté \p T dont la clé est strictement inférieure à \p key :
+ * c'est le rang du premier nœud de clé supérieure ou égale à \p key (voir tree_iter_begin_at).
+ * 
+ * @param[in] T 
+ * @param[in] key 
+ * @return int 
+ */
+int tree_rank(const struct tree_t * T, const void * key);
+
+/**
+ * @brief
+ * Restitue la somme des poids des \p k premières clés (dans l'ordre croissant) de l'arbre augmenté \p T,
+ * avec 0 <= \p k <= get_tree_size(T) : par exemple, la somme des poids des clés inférieures à une clé
+ * s'obtient avec tree_prefix_sum(T, tree_rank(T, key)), et la somme totale avec k = get_tree_size(T).
+ * 
+ * @param[in] T 
+ * @param[in] k 
+ * @return unsigned long 
+ */
+unsigned long tree_prefix_sum(const struct tree_t * T, int k);
+
+/**
+ * @brief
+ * Renvoie 1 si les \p n clés du tableau \p keys sont triées par ordre croissant
+ * (au sens large) selon \p preceed, sinon renvoie 0. Le tableau est parcouru une fois.
+ * 
+ * @param[in] keys 
+ * @param[in] n 
+ * @param[in] preceed 
+ * @return int 
+ */
+int tree_keys_are_sorted(void ** keys, int n, int (*preceed)(const void *, const void *));
+
+/**
+ * @brief
+ * Remplir l'arbre vide \p T avec les \p n éléments de clés \p keys et de données \p data,
+ * où les clés sont triées par ordre croissant (voir tree_keys_are_sorted).
+ * L'arbre obtenu est parfaitement équilibré (c'est un AVL valide, avec les bons facteurs d'équilibre,
+ * ou un arbre rouge-noir valide dont seul le dernier niveau, s'il est incomplet, est rouge)
+ * et il est construit en O(n), sans rotation.
+ * Les clés égales sont rangées dans l'ordre du tableau, comme avec des insertions successives.
+ * 
+ * @param[in] T 
+ * @param[in] keys 
+ * @param[in] data 
+ * @param[in] n 
+ */
+void tree_build_from_sorted(struct tree_t * T, void ** keys, void ** data, int n);
+
 #endif // _TREE_H_
\ No newline at end of file
@@ -0,0 +1,333 @@
+#ifndef _TREE_TEMPLATE_H_
+#define _TREE_TEMPLATE_H_
+
+/**
+ * @brief
+ * Le fichier définit un "template" d'arbre AVL spécialisé pour un type de clé :
+ * TREE_DEFINE(name, key_type, less) génère les types struct name_node_t et struct name_t
+ * et les fonctions name_new, name_delete, name_is_empty, name_size, name_min, name_insert,
+ * name_remove_node, name_pop_min et name_build_from_sorted.
+ * L'algorithme est celui de tree.c pour un arbre AVL dont les clés sont stockées par valeur,
+ * mais les clés sont typées et la comparaison less(const key_type *, const key_type *) est un appel direct,
+ * que le compilateur peut donc remplacer par son code : il n'y a ni pointeur de fonction ni void *.
+ * Toutes les fonctions générées sont static inline : l'instanciation se fait dans le fichier .c qui l'utilise.
+ *
+ * Exemple :
+ *     static inline int int_less(const int * a, const int * b) { return *a < *b; }
+ *     TREE_DEFINE(int_tree, int, int_less)
+ *     struct int_tree_t * T = int_tree_new();
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "pool.h"
+#include "util.h"
+
+/**
+ * @brief
+ * Générer l'arbre AVL \p name dont les clés sont de type \p key_type et sont comparées avec \p less
+ * (renvoie 1 si la première clé précède strictement la seconde, 0 sinon).
+ * Comme dans tree.c, une clé égale à des clés existantes est placée après elles (ordre d'insertion conservé),
+ * les nœuds ont une référence vers leur père, le minimum est gardé en mémoire (leftmost),
+ * et un nœud reste associé à son élément tant qu'il est dans l'arbre (il sert de référence pour name_remove_node).
+ */
+#define TREE_DEFINE(name, key_type, less) \
+	TREE_DEFINE_TYPES_(name, key_type) \
+	TREE_DEFINE_BASICS_(name, key_type) \
+	TREE_DEFINE_ROTATIONS_(name) \
+	TREE_DEFINE_INSERT_(name, key_type, less) \
+	TREE_DEFINE_REMOVE_(name) \
+	TREE_DEFINE_BUILD_(name, key_type)
+
+/**
+ * @brief
+ * Un nœud contient sa clé (key) par valeur, sa donnée (data), ses références left, right et parent,
+ * et son facteur d'équilibre (bfactor) : hauteur du fils gauche - hauteur du fils droit.
+ * L'arbre contient sa racine (root), son nœud de clé minimum (leftmost), son nombre d'éléments (numelm)
+ * et la réserve (pool) de ses nœuds.
+ */
+#define TREE_DEFINE_TYPES_(name, key_type) \
+	struct name##_node_t { \
+		key_type key; \
+		void * data; \
+		struct name##_node_t * left; \
+		struct name##_node_t * right; \
+		struct name##_node_t * parent; \
+		int bfactor; \
+	}; \
+	struct name##_t { \
+		struct name##_node_t * root; \
+		struct name##_node_t * leftmost; \
+		int numelm; \
+		struct pool_t * pool; \
+	};
+
+/**
+ * @brief
+ * name_new construit un arbre vide, name_delete le supprime (avec les données si \p freeData n'est pas NULL),
+ * name_min restitue le nœud de clé minimum (NULL si l'arbre est vide) en temps constant.
+ */
+#define TREE_DEFINE_BASICS_(name, key_type) \
+	static inline struct name##_t * name##_new(void) { \
+		struct name##_t * T = malloc(sizeof(struct name##_t)); \
+		if (T == NULL) { \
+			ShowMessage("include.tree_template.h:" #name "_new : allocation impossible", 1); \
+		} \
+		T->root = NULL; \
+		T->leftmost = NULL; \
+		T->numelm = 0; \
+		T->pool = new_pool(sizeof(struct name##_node_t)); \
+		return T; \
+	} \
+	static inline int name##_is_empty(const struct name##_t * T) { \
+		return (T->numelm == 0); \
+	} \
+	static inline int name##_size(const struct name##_t * T) { \
+		return T->numelm; \
+	} \
+	static inline struct name##_node_t * name##_min(const struct name##_t * T) { \
+		return T->leftmost; \
+	} \
+	static inline struct name##_node_t * name##_next_(struct name##_node_t * curr) { \
+		if (curr->right != NULL) { \
+			curr = curr->right; \
+			while (curr->left != NULL) { \
+				curr = curr->left; \
+			} \
+			return curr; \
+		} \
+		while (curr->parent != NULL && curr == curr->parent->right) { \
+			curr = curr->parent; \
+		} \
+		return curr->parent; \
+	} \
+	static inline void name##_delete(struct name##_t * T, void (*freeData)(void *)) { \
+		assert(T != NULL); \
+		if (freeData != NULL) { \
+			for (struct name##_node_t * curr = T->leftmost; curr != NULL; curr = name##_next_(curr)) { \
+				freeData(curr->data); \
+			} \
+		} \
+		delete_pool(T->pool); \
+		free(T); \
+	}
+
+/**
+ * @brief
+ * Rotations gauche et droite autour du nœud x (voir rotate_left et rotate_right dans tree.c),
+ * avec mise à jour des références parent et des facteurs d'équilibre, et rééquilibrage
+ * d'un nœud de facteur d'équilibre 2 ou -2 (voir rebalance dans tree.c).
+ */
+#define TREE_DEFINE_ROTATIONS_(name) \
+	static inline void name##_replace_child_(struct name##_t * T, struct name##_node_t * parent, \
+						struct name##_node_t * oldChild, struct name##_node_t * newChild) { \
+		if (parent == NULL) { \
+			T->root = newChild; \
+		} else if (parent->left == oldChild) { \
+			parent->left = newChild; \
+		} else { \
+			parent->right = newChild; \
+		} \
+	} \
+	static inline struct name##_node_t * name##_rotate_left_(struct name##_t * T, struct name##_node_t * x) { \
+		struct name##_node_t * y = x->right; \
+		x->right = y->left; \
+		if (y->left != NULL) { \
+			y->left->parent = x; \
+		} \
+		y->parent = x->parent; \
+		name##_replace_child_(T, x->parent, x, y); \
+		y->left = x; \
+		x->parent = y; \
+		x->bfactor += 1 - min(y->bfactor, 0); \
+		y->bfactor += 1 + max(x->bfactor, 0); \
+		return y; \
+	} \
+	static inline struct name##_node_t * name##_rotate_right_(struct name##_t * T, struct name##_node_t * x) { \
+		struct name##_node_t * y = x->left; \
+		x->left = y->right; \
+		if (y->right != NULL) { \
+			y->right->parent = x; \
+		} \
+		y->parent = x->parent; \
+		name##_replace_child_(T, x->parent, x, y); \
+		y->right = x; \
+		x->parent = y; \
+		x->bfactor -= 1 + max(y->bfactor, 0); \
+		y->bfactor -= 1 - min(x->bfactor, 0); \
+		return y; \
+	} \
+	static inline struct name##_node_t * name##_rebalance_(struct name##_t * T, struct name##_node_t * curr) { \
+		if (curr->bfactor == 2) { \
+			if (curr->left->bfactor < 0) { \
+				name##_rotate_left_(T, curr->left); \
+			} \
+			return name##_rotate_right_(T, curr); \
+		} \
+		if (curr->right->bfactor > 0) { \
+			name##_rotate_right_(T, curr->right); \
+		} \
+		return name##_rotate_left_(T, curr); \
+	}
+
+/**
+ * @brief
+ * name_insert ajoute une copie de la clé *key avec la donnée data et restitue le nouveau nœud
+ * (voir tree_insert) : la recherche de la position n'appelle que less.
+ */
+#define TREE_DEFINE_INSERT_(name, key_type, less) \
+	static inline struct name##_node_t * name##_insert(struct name##_t * T, const key_type * key, void * data) { \
+		struct name##_node_t * parent = NULL; \
+		struct name##_node_t * curr = T->root; \
+		int left = 0; \
+		while (curr != NULL) { \
+			parent = curr; \
+			left = less(key, &curr->key); \
+			curr = left ? curr->left : curr->right; \
+		} \
+		struct name##_node_t * node = pool_alloc(T->pool); \
+		node->key = *key; \
+		node->data = data; \
+		node->left = NULL; \
+		node->right = NULL; \
+		node->parent = parent; \
+		node->bfactor = 0; \
+		if (parent == NULL) { \
+			T->root = node; \
+			T->leftmost = node; \
+		} else if (left) { \
+			parent->left = node; \
+			if (parent == T->leftmost) { \
+				T->leftmost = node; \
+			} \
+		} else { \
+			parent->right = node; \
+		} \
+		T->numelm++; \
+		for (curr = node, parent = node->parent; parent != NULL; curr = parent, parent = parent->parent) { \
+			parent->bfactor += (curr == parent->left) ? 1 : -1; \
+			if (parent->bfactor == 0) { \
+				break; \
+			} \
+			if (parent->bfactor == 2 || parent->bfactor == -2) { \
+				name##_rebalance_(T, parent); \
+				break; \
+			} \
+		} \
+		return node; \
+	}
+
+/**
+ * @brief
+ * name_remove_node supprime le nœud node et restitue sa donnée (voir tree_remove_node) ;
+ * name_pop_min supprime le nœud de clé minimum et restitue sa donnée (voir tree_pop_min).
+ */
+#define TREE_DEFINE_REMOVE_(name) \
+	static inline void * name##_remove_node(struct name##_t * T, struct name##_node_t * node) { \
+		struct name##_node_t * parent; \
+		int fromLeft; \
+		void * data = node->data; \
+		if (node == T->leftmost) { \
+			T->leftmost = name##_next_(node); \
+		} \
+		if (node->left != NULL && node->right != NULL) { \
+			struct name##_node_t * succ = node->right; \
+			while (succ->left != NULL) { \
+				succ = succ->left; \
+			} \
+			if (succ->parent != node) { \
+				parent = succ->parent; \
+				fromLeft = 1; \
+				parent->left = succ->right; \
+				if (succ->right != NULL) { \
+					succ->right->parent = parent; \
+				} \
+				succ->right = node->right; \
+				node->right->parent = succ; \
+			} else { \
+				parent = succ; \
+				fromLeft = 0; \
+			} \
+			succ->left = node->left; \
+			node->left->parent = succ; \
+			succ->parent = node->parent; \
+			name##_replace_child_(T, node->parent, node, succ); \
+			succ->bfactor = node->bfactor; \
+		} else { \
+			struct name##_node_t * child = (node->left != NULL) ? node->left : node->right; \
+			parent = node->parent; \
+			fromLeft = (parent != NULL && parent->left == node); \
+			if (child != NULL) { \
+				child->parent = parent; \
+			} \
+			name##_replace_child_(T, parent, node, child); \
+		} \
+		while (parent != NULL) { \
+			parent->bfactor += fromLeft ? -1 : 1; \
+			if (parent->bfactor == 1 || parent->bfactor == -1) { \
+				break; \
+			} \
+			if (parent->bfactor == 2 || parent->bfactor == -2) { \
+				int sibling = (parent->bfactor == 2) ? parent->left->bfactor : parent->right->bfactor; \
+				parent = name##_rebalance_(T, parent); \
+				if (sibling == 0) { \
+					break; \
+				} \
+			} \
+			struct name##_node_t * up = parent->parent; \
+			fromLeft = (up != NULL && up->left == parent); \
+			parent = up; \
+		} \
+		pool_free(T->pool, node); \
+		T->numelm--; \
+		return data; \
+	} \
+	static inline void * name##_pop_min(struct name##_t * T) { \
+		assert(!name##_is_empty(T)); \
+		return name##_remove_node(T, T->leftmost); \
+	}
+
+/**
+ * @brief
+ * name_build_from_sorted remplit l'arbre vide T avec les n clés du tableau keys, triées par ordre croissant,
+ * et les données data, en O(n) (voir tree_build_from_sorted).
+ */
+#define TREE_DEFINE_BUILD_(name, key_type) \
+	static inline int name##_height_(int n) { \
+		int h = 0; \
+		while (n > 0) { \
+			n /= 2; \
+			h++; \
+		} \
+		return h; \
+	} \
+	static inline struct name##_node_t * name##_build_(struct name##_t * T, const key_type * keys, void ** data, \
+						int lo, int hi, struct name##_node_t * parent) { \
+		if (lo >= hi) { \
+			return NULL; \
+		} \
+		int mid = lo + (hi - lo) / 2; \
+		struct name##_node_t * node = pool_alloc(T->pool); \
+		node->key = keys[mid]; \
+		node->data = data[mid]; \
+		node->parent = parent; \
+		node->left = name##_build_(T, keys, data, lo, mid, node); \
+		node->right = name##_build_(T, keys, data, mid + 1, hi, node); \
+		node->bfactor = name##_height_(mid - lo) - name##_height_(hi - mid - 1); \
+		return node; \
+	} \
+	static inline void name##_build_from_sorted(struct name##_t * T, const key_type * keys, void ** data, int n) { \
+		assert(name##_is_empty(T)); \
+		if (n == 0) { \
+			return; \
+		} \
+		T->root = name##_build_(T, keys, data, 0, n, NULL); \
+		T->leftmost = T->root; \
+		while (T->leftmost->left != NULL) { \
+			T->leftmost = T->leftmost->left; \
+		} \
+		T->numelm = n; \
+	}
+
+#endif // _TREE_TEMPLATE_H_
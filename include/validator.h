@@ -0,0 +1,77 @@
+#ifndef _VALIDATOR_H_
+#define _VALIDATOR_H_
+
+/**
+ * @brief
+ * Le fichier définit la vérification de la faisabilité d'un ordonnancement par rapport à une instance.
+ */
+
+#include "instance.h"
+
+struct schedule_t;
+
+/**
+ * @brief Les types de violation détectés par validate_schedule.
+ */
+#define VIOLATION_NONE 0		// la machine ne contient pas de violation
+#define VIOLATION_UNKNOWN_TASK 1	// la tâche du segment n'appartient pas à l'instance
+#define VIOLATION_EMPTY 2		// la fin du segment n'est pas après son début
+#define VIOLATION_RELEASE 3		// le segment commence avant la date de libération de sa tâche
+#define VIOLATION_OVERLAP 4		// le segment commence avant la fin du segment précédent de la machine
+#define VIOLATION_PROCESSING_TIME 5	// la somme des durées des segments de la tâche diffère de sa durée
+
+/**
+ * @brief
+ * La première violation d'une machine est décrite par
+ * (+) son type (type, VIOLATION_NONE si la machine est correcte),
+ * (+) l'indice (segment) du segment fautif dans l'ordonnancement de la machine (-1 si type vaut VIOLATION_NONE), et
+ * (+) sa tâche (task, NULL si type vaut VIOLATION_NONE).
+ *
+ * NB : la "première" violation est celle du segment qui commence le plus tôt sur la machine.
+ */
+struct schedule_violation_t {
+	int type;
+	int segment;
+	struct task_t * task;
+};
+
+/**
+ * @brief Vérifier que l'ordonnancement \p S est une solution faisable de l'instance \p I, c'est-à-dire
+ * (+) que chaque segment a une tâche de l'instance (identifiée par son id) et une durée non nulle,
+ * (+) qu'aucun segment ne commence avant la date de libération de sa tâche,
+ * (+) que les segments d'une machine ne se chevauchent pas, et
+ * (+) que la somme des durées des segments de chaque tâche est égale à sa durée.
+ * La première violation de chaque machine est écrite dans \p violations (tableau de get_num_machines(S) cases).
+ *
+ * NB1 : les machines sont réparties entre \p num_threads fils d'exécution (le nombre de processeurs
+ * si \p num_threads <= 0). Le coût est O(n log n) pour n segments et tâches : les identifiants de
+ * l'instance sont triés une fois, et les segments d'une machine ne sont triés par date de début
+ * que s'ils ne le sont pas déjà.
+ *
+ * NB2 : une tâche de l'instance qui n'apparaît dans aucun segment n'est rattachée à aucune machine ;
+ * le nombre de ces tâches est écrit dans \p num_unscheduled s'il n'est pas NULL.
+ *
+ * @param[in] S
+ * @param[in] I
+ * @param[in] num_threads
+ * @param[out] violations
+ * @param[out] num_unscheduled
+ * @return int le nombre de machines qui contiennent une violation
+ */
+int validate_schedule(const struct schedule_t * S, Instance I, int num_threads,
+						struct schedule_violation_t * violations, int * num_unscheduled);
+
+/**
+ * @brief Lire l'ordonnancement du fichier \p filename au format des fichiers data/solution_* :
+ * le nombre de machines, puis pour chaque machine une ligne "M<indice>" suivie des lignes
+ * "begin_time end_time id" de ses segments. Les tâches sont celles de l'instance \p I.
+ * Si un segment a une tâche inconnue ou une fin qui n'est pas après son début, le fichier
+ * ne peut pas être représenté : un message est affiché et la valeur retournée est NULL.
+ *
+ * @param[in] filename
+ * @param[in] I
+ * @return struct schedule_t*
+ */
+struct schedule_t * read_solution(const char * filename, Instance I);
+
+#endif // _VALIDATOR_H_
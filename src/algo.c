@@ -11,6 +11,8 @@
 #include "tree.h"
 #include "instance.h"
 #include "schedule.h"
+#include "event_queue.h"
+#include "tree_template.h"
 
 /********************************************************************
  * event_key_t
@@ -101,6 +103,18 @@ int get_event_machine(const struct event_key_t * key) {
 	return key->machine;//on retourne machine de la clé
 }
 
+/**
+ * @brief Restitue la date de l'événement de clé \p key.
+ * Le type de l'argument est void* pour être utilisé comme pointeur de fonction
+ * par les ensembles d'événements qui ordonnent les clés par date (voir event_queue.h).
+ *
+ * @param[in] key
+ * @return unsigned long
+ */
+static unsigned long event_key_time(const void * key) {
+	return get_event_time(key);
+}
+
 /**
  * @brief 
  * 
@@ -209,85 +223,520 @@ int ready_task_preceed(const void * a, const void * b) {
 	return (get_ready_task_remaining_processing_time(a) < get_ready_task_remaining_processing_time(b));//on compare les valeurs de la clé
 }
 
+/********************************************************************
+ * Arbres spécialisés (voir tree_template.h)
+ ********************************************************************/
+
+/**
+ * @brief Version typée de event_preceed, lisant directement les champs des clés \p a et \p b.
+ *
+ * @param[in] a
+ * @param[in] b
+ * @return int
+ */
+static inline int event_key_less(const struct event_key_t * a, const struct event_key_t * b) {
+	return (a->event_time < b->event_time) || (a->event_time == b->event_time && a->processing_time < b->processing_time);
+}
+
+/**
+ * @brief Version typée de ready_task_preceed, lisant directement les champs des clés \p a et \p b.
+ *
+ * @param[in] a
+ * @param[in] b
+ * @return int
+ */
+static inline int ready_task_key_less(const struct ready_task_key_t * a, const struct ready_task_key_t * b) {
+	return (a->remaining_processing_time < b->remaining_processing_time);
+}
+
+TREE_DEFINE(event_tree, struct event_key_t, event_key_less)
+TREE_DEFINE(ready_tree, struct ready_task_key_t, ready_task_key_less)
+
 /********************************************************************
  * The algorithm
  ********************************************************************/
 
 
-struct schedule_t * create_schedule(Instance I, int num_m, int preemption, int balanced_tree) {
-   struct schedule_t *S = new_schedule(num_m);
-    
-    //Arbre qui contient les ready_task en file d'attente Q 
-    struct tree_t *Q = new_tree(balanced_tree, ready_task_preceed, view_ready_task_key, view_task, delete_ready_task_key, delete_task);
-    
-    //Arbre qui contient l'ensemble des evenements 
-    struct tree_t *E = new_tree(balanced_tree,event_preceed,view_event_key,view_task,delete_event_key,delete_task);
-    
-    //Ajouter les dates de libération de toutes les tâches dans l'ensemble des événements
-    for(struct list_node_t *curr = get_list_head(I); curr != NULL ; curr = get_successor(curr)) {
+/**
+ * @brief
+ * Choisir l'implémentation de l'ensemble des événements à partir
+ * du paramètre \p balanced_tree de create_schedule :
+ * (+) 0 : arbre binaire de recherche non-équilibré,
+ * (+) 1 : arbre binaire de recherche équilibré (AVL),
+ * (+) 2 : tas d-aire,
+ * (+) 3 : flot des libérations trié une fois, fusionné avec un petit tas des fins d'exécution,
+ * (+) 4 : tas radix sur les dates des événements,
+ * (+) 5 : file calendrier sur les dates des événements,
+ * (+) 6 : arbre binaire de recherche équilibré (rouge-noir),
+ * (+) 7 : arbre binaire de recherche équilibré (AVL), la file d'attente étant un arbre B+.
+ * La valeur 8 (arbres spécialisés) est traitée par fill_schedule_specialized.
+ *
+ * @param[in] balanced_tree
+ * @return int Le type d'ensemble d'événements (voir event_queue.h).
+ */
+static int event_queue_type(int balanced_tree) {
+	switch (balanced_tree) {
+		case 0:
+			return EVENT_QUEUE_BST;
+		case 1:
+			return EVENT_QUEUE_AVL;
+		case 2:
+			return EVENT_QUEUE_HEAP;
+		case 3:
+			return EVENT_QUEUE_STREAM;
+		case 4:
+			return EVENT_QUEUE_RADIX;
+		case 5:
+			return EVENT_QUEUE_CALENDAR;
+		case 6:
+			return EVENT_QUEUE_RBT;
+		case 7:
+			return EVENT_QUEUE_AVL;
+		default:
+			ShowMessage("src.algo.c:create_schedule : valeur de balanced inconnue", 1);
+	}
+	return -1;
+}
+
+/**
+ * @brief
+ * Choisir l'implémentation de la file d'attente à partir du paramètre \p balanced_tree
+ * de create_schedule : arbre binaire de recherche non-équilibré (0), arbre rouge-noir (6),
+ * arbre B+ (7), arbre AVL sinon.
+ *
+ * @param[in] balanced_tree
+ * @return int Le type de file (voir event_queue.h).
+ */
+static int ready_queue_type(int balanced_tree) {
+	switch (balanced_tree) {
+		case 0:
+			return EVENT_QUEUE_BST;
+		case 6:
+			return EVENT_QUEUE_RBT;
+		case 7:
+			return EVENT_QUEUE_BTREE;
+		default:
+			return EVENT_QUEUE_AVL;
+	}
+}
+
+/**
+ * @brief
+ * Un curseur de libérations parcourt les tâches de l'instance dans l'ordre de leurs événements
+ * "libération" (date de libération, puis durée, puis ordre de l'instance) : create_schedule_streaming
+ * n'ajoute à E que la prochaine libération au lieu de toutes dès le départ.
+ * Si l'instance est déjà triée, le curseur avance dans la liste (node) ;
+ * sinon il avance dans un tableau trié des tâches (order, de taille size, prochaine tâche next).
+ */
+struct release_cursor_t {
+	struct list_node_t * node;
+	struct task_t ** order;
+	int next;
+	int size;
+};
+
+/**
+ * @brief Même ordre que event_key_less sur les événements "libération" des tâches \p a et \p b.
+ *
+ * @param[in] a
+ * @param[in] b
+ * @return int
+ */
+static inline int task_release_less(const struct task_t * a, const struct task_t * b) {
+	unsigned long ra = get_task_release_time(a), rb = get_task_release_time(b);
+	return (ra < rb) || (ra == rb && get_task_processing_time(a) < get_task_processing_time(b));
+}
+
+/**
+ * @brief
+ * Trier les \p n tâches de \p tasks par libération (task_release_less) avec un tri fusion stable :
+ * les tâches de même libération gardent l'ordre de l'instance, comme dans E.
+ *
+ * @param[in] tasks
+ * @param[in] n
+ */
+static void sort_releases(struct task_t ** tasks, int n) {
+	struct task_t ** tmp = malloc(n * sizeof(struct task_t *));
+	if (n > 0 && tmp == NULL) {
+		ShowMessage("src.algo.c:create_schedule_streaming : allocation impossible", 1);
+	}
+	struct task_t ** src = tasks, ** dst = tmp;
+	for (int width = 1; width < n; width *= 2) {//fusion des séquences triées de taille width
+		for (int lo = 0; lo < n; lo += 2 * width) {
+			int mid = min(lo + width, n), hi = min(lo + 2 * width, n);
+			int i = lo, j = mid, k = lo;
+			while (i < mid && j < hi) {
+				dst[k++] = task_release_less(src[j], src[i]) ? src[j++] : src[i++];
+			}
+			while (i < mid) {
+				dst[k++] = src[i++];
+			}
+			while (j < hi) {
+				dst[k++] = src[j++];
+			}
+		}
+		struct task_t ** swap = src;
+		src = dst;
+		dst = swap;
+	}
+	if (src != tasks) {
+		memcpy(tasks, src, n * sizeof(struct task_t *));
+	}
+	free(tmp);
+}
+
+/**
+ * @brief
+ * Placer le curseur \p C avant la première libération de l'instance \p I.
+ * Le tableau trié n'est construit que si l'instance n'est pas déjà triée par libération.
+ *
+ * @param[out] C
+ * @param[in] I
+ */
+static void init_release_cursor(struct release_cursor_t * C, Instance I) {
+	C->node = get_list_head(I);
+	C->order = NULL;
+	C->next = 0;
+	C->size = 0;
+	int sorted = 1;
+	for (struct list_node_t *curr = C->node; curr != NULL && get_successor(curr) != NULL && sorted; curr = get_successor(curr)) {
+		sorted = !task_release_less(get_list_node_data(get_successor(curr)), get_list_node_data(curr));
+	}
+	if (sorted) {
+		return;
+	}
+	int n = get_list_size(I);
+	C->order = malloc(n * sizeof(struct task_t *));
+	if (C->order == NULL) {
+		ShowMessage("src.algo.c:create_schedule_streaming : allocation impossible", 1);
+	}
+	for (struct list_node_t *curr = C->node; curr != NULL; curr = get_successor(curr)) {
+		C->order[C->size++] = get_list_node_data(curr);
+	}
+	sort_releases(C->order, n);
+	C->node = NULL;
+}
+
+/**
+ * @brief Restituer la prochaine tâche libérée du curseur \p C et avancer le curseur (NULL à la fin).
+ *
+ * @param[in] C
+ * @return struct task_t*
+ */
+static struct task_t * next_release(struct release_cursor_t * C) {
+	if (C->order != NULL) {
+		return C->next < C->size ? C->order[C->next++] : NULL;
+	}
+	if (C->node == NULL) {
+		return NULL;
+	}
+	struct task_t * task = get_list_node_data(C->node);
+	C->node = get_successor(C->node);
+	return task;
+}
+
+/**
+ * @brief
+ * Ajouter à E (opérations de préfixe \p events) l'événement "libération" de la prochaine tâche
+ * du curseur \p releases, s'il en reste une.
+ */
+#define INSERT_NEXT_RELEASE(events, E, releases) do { \
+    struct task_t *released = next_release(releases); \
+    if (released != NULL) { \
+        struct event_key_t releaseEvent = { 0, get_task_release_time(released), get_task_processing_time(released), get_task_id(released), 0 }; \
+        events##_insert(E, &releaseEvent, released); \
+    } \
+} while (0)
+
+/**
+ * @brief
+ * Générer la boucle d'événements de create_schedule, \p name, pour un ensemble d'événements E
+ * de type \p events_type et une file d'attente Q de type \p ready_type, dont les opérations sont
+ * les fonctions de préfixe \p events et \p ready : _is_empty, _min_key (clé minimum),
+ * _pop_min (extraire le minimum et restituer sa donnée) et _insert (restituer une référence,
+ * de type \p handle_type pour E), ainsi que events_remove_node (retirer un événement par sa référence).
+ * L'algorithme est écrit une fois : fill_schedule l'instancie avec l'ensemble d'événements générique,
+ * fill_schedule_specialized avec les arbres spécialisés event_tree et ready_tree, dont les appels
+ * sont directs.
+ *
+ * La fonction générée prend l'ordonnancement vide S à remplir, E, Q vide, preemption et releases :
+ * si releases est NULL, E contient déjà les libérations de toutes les tâches ; sinon E est vide
+ * et les libérations sont lues une à une sur le curseur releases. La libération suivante entre dans E
+ * quand la précédente en sort : comme elle suit toutes les autres dans l'ordre des événements
+ * (une libération et une fin d'exécution n'ont jamais la même clé, car leurs durées diffèrent),
+ * l'ordonnancement est le même, et E ne contient que les fins d'exécution en cours et une libération.
+ */
+#define FILL_SCHEDULE_DEFINE(name, events, events_type, ready, ready_type, handle_type) \
+static void name(struct schedule_t * S, events_type * E, ready_type * Q, int preemption, \
+                    struct release_cursor_t * releases) { \
+    int num_m = get_num_machines(S); \
+    /* Référence, pour chaque machine, de l'événement "fin d'exécution" en attente dans E : */ \
+    /* elle permet de le retirer lors d'une préemption sans reconstruire sa clé */ \
+    handle_type *endEvents = calloc(num_m, sizeof(handle_type)); \
+    if (num_m > 0 && endEvents == NULL) { \
+        ShowMessage("src.algo.c:create_schedule : allocation impossible", 1); \
+    } \
+    if (releases != NULL) { \
+        INSERT_NEXT_RELEASE(events, E, releases); \
+    } \
+    while(!events##_is_empty(E)) { \
+        /* Extraire le prochain événement de E (on copie sa clé avant l'extraction) */ \
+        struct event_key_t eventMin = *events##_min_key(E); \
+        struct task_t *task = events##_pop_min(E); \
+        unsigned long time = get_event_time(&eventMin); \
+        if(get_event_type(&eventMin) == 0) { /* Si l'événement est la libération d'une tâche Tj */ \
+            if (releases != NULL) { /* La libération suivante la remplace dans E */ \
+                INSERT_NEXT_RELEASE(events, E, releases); \
+            } \
+            unsigned long processing_time = get_event_processing_time(&eventMin); \
+            int emptyMachine = find_empty_machine(S, time); \
+            if(emptyMachine != -1) { /* Si une machine est libre à l'instant de libération de la tâche Tj */ \
+                add_task_to_schedule(S, task, emptyMachine, time, time + processing_time); \
+                /* Ajouter l'événement "fin d'exécution" de la tâche Tj dans l'ensemble des événements */ \
+                struct event_key_t endEvent = { 1, time + processing_time, 0, get_task_id(task), emptyMachine }; \
+                endEvents[emptyMachine] = events##_insert(E, &endEvent, task); \
+            } else if (preemption) { /* Si toutes les machines sont occupées et on est en mode préemptif */ \
+                int interMachine = find_machine_to_interrupt(S, time, processing_time); \
+                if(interMachine != -1 ) { \
+                    /* Préempter la tâche en cours d'exécution sur la machine interMachine */ \
+                    struct machine_schedule_t * MS = get_schedule_of_machine(S, interMachine); \
+                    struct task_t * interrupted = get_machine_schedule_task(MS, get_machine_schedule_size(MS) - 1); \
+                    unsigned long old_et = preempt_task(S, interMachine, time); \
+                    /* On supprime de E l'événement de fin de la tâche interrompue grâce à sa référence */ \
+                    events##_remove_node(E, endEvents[interMachine]); \
+                    /* Ajouter la tâche interrompue dans la file d'attente Q avec sa durée restante */ \
+                    struct ready_task_key_t intr_key = { old_et - time, get_task_id(interrupted) }; \
+                    ready##_insert(Q, &intr_key, interrupted); \
+                    /* Ajouter l'événement "fin d'exécution" de la tâche Tj dans l'ensemble des événements */ \
+                    struct event_key_t endEvent2 = { 1, time + processing_time, 0, get_task_id(task), interMachine }; \
+                    endEvents[interMachine] = events##_insert(E, &endEvent2, task); \
+                    /* Affecter la tâche Tj à la machine interMachine */ \
+                    add_task_to_schedule(S, task, interMachine, time, time + processing_time); \
+                } else { /* On est en mode préémptif, mais on n'a pas pu faire de préemption */ \
+                    struct ready_task_key_t in_key = { processing_time, get_task_id(task) }; \
+                    ready##_insert(Q, &in_key, task); \
+                } \
+            } else { /* Si toutes les machines sont occupées et on n'est pas en mode préemptif, ajouter Tj dans Q */ \
+                struct ready_task_key_t rt_key = { processing_time, get_task_id(task) }; \
+                ready##_insert(Q, &rt_key, task); \
+            } \
+        } else { /* Si l'événement est la fin d'exécution d'une tâche Tj */ \
+            endEvents[get_event_machine(&eventMin)] = NULL; /* l'événement a quitté E */ \
+            if(!ready##_is_empty(Q)) { /* Si la file d'attente Q n'est pas vide */ \
+                /* Extraire de Q la tâche Tk avec la durée la plus courte (règle SPT) */ \
+                unsigned long remaining = get_ready_task_remaining_processing_time(ready##_min_key(Q)); \
+                struct task_t *next = ready##_pop_min(Q); \
+                /* Affecter Tk à la machine qui vient de libérer Mi */ \
+                int machine = get_event_machine(&eventMin); \
+                add_task_to_schedule(S, next, machine, time, time + remaining); \
+                /* Ajouter l'événement "fin d'exécution" de la tâche Tk dans l'ensemble des événements */ \
+                struct event_key_t endEvent = { 1, time + remaining, 0, get_task_id(next), machine }; \
+                endEvents[machine] = events##_insert(E, &endEvent, next); \
+            } \
+        } \
+    } \
+    free(endEvents); \
+}
+
+/**
+ * @brief Opérations de FILL_SCHEDULE_DEFINE sur l'ensemble d'événements générique (E, préfixe event_set)
+ * et sur la file d'attente générique (Q, préfixe ready_set).
+ */
+static inline int event_set_is_empty(const struct event_queue_t * E) {
+	return event_queue_is_empty(E);
+}
+
+static inline const struct event_key_t * event_set_min_key(struct event_queue_t * E) {
+	return get_event_queue_min_key(E);
+}
+
+static inline void * event_set_pop_min(struct event_queue_t * E) {
+	return event_queue_pop_min(E, NULL);
+}
+
+static inline void * event_set_insert(struct event_queue_t * E, const struct event_key_t * key, void * data) {
+	return event_queue_insert(E, (void *) key, data);
+}
+
+static inline void event_set_remove_node(struct event_queue_t * E, void * handle) {
+	event_queue_remove_handle(E, handle);
+}
+
+static inline int ready_set_is_empty(const struct event_queue_t * Q) {
+	return event_queue_is_empty(Q);
+}
+
+static inline const struct ready_task_key_t * ready_set_min_key(struct event_queue_t * Q) {
+	return get_event_queue_min_key(Q);
+}
+
+static inline void * ready_set_pop_min(struct event_queue_t * Q) {
+	return event_queue_pop_min(Q, NULL);//la copie de la clé disparaît avec l'élément
+}
+
+static inline void ready_set_insert(struct event_queue_t * Q, const struct ready_task_key_t * key, void * data) {
+	event_queue_insert(Q, (void *) key, data);
+}
+
+/**
+ * @brief Opérations de FILL_SCHEDULE_DEFINE propres aux arbres spécialisés : les autres
+ * (_is_empty, _pop_min, _insert, _remove_node) sont générées par TREE_DEFINE.
+ */
+static inline const struct event_key_t * event_tree_min_key(const struct event_tree_t * E) {
+	return &event_tree_min(E)->key;
+}
+
+static inline const struct ready_task_key_t * ready_tree_min_key(const struct ready_tree_t * Q) {
+	return &ready_tree_min(Q)->key;
+}
+
+FILL_SCHEDULE_DEFINE(run_events, event_set, struct event_queue_t, ready_set, struct event_queue_t, void *)
+FILL_SCHEDULE_DEFINE(run_events_specialized, event_tree, struct event_tree_t, ready_tree, struct ready_tree_t,
+						struct event_tree_node_t *)
+
+/**
+ * @brief Construire le tableau des événements "libération" des tâches de l'instance \p I,
+ * dans l'ordre de l'instance, et le tableau de leurs tâches (\p tasks).
+ *
+ * @param[in] I
+ * @param[out] tasks
+ * @return struct event_key_t*
+ */
+static struct event_key_t * new_release_events(Instance I, void *** tasks) {
+    int n = get_list_size(I);
+    struct event_key_t *releases = malloc(n * sizeof(struct event_key_t));
+    *tasks = malloc(n * sizeof(void *));
+    if (n > 0 && (releases == NULL || *tasks == NULL)) {
+        ShowMessage("src.algo.c:create_schedule : allocation impossible", 1);
+    }
+    int i = 0;
+    for(struct list_node_t *curr = get_list_head(I); curr != NULL ; curr = get_successor(curr), i++) {
         struct task_t *task = get_list_node_data(curr);
-        struct event_key_t *ev = new_event_key(0, get_task_release_time(task), get_task_processing_time(task), get_task_id(task), 0);
-        tree_insert(E, ev, task);
+        releases[i] = (struct event_key_t) { 0, get_task_release_time(task), get_task_processing_time(task), get_task_id(task), 0 };
+        (*tasks)[i] = task;
+    }
+    return releases;
+}
+
+/**
+ * @brief
+ * Même algorithme que create_schedule, avec pour E et Q des arbres AVL spécialisés pour
+ * struct event_key_t et struct ready_task_key_t (event_tree et ready_tree, générés par TREE_DEFINE) :
+ * les comparaisons sont des appels directs à event_key_less et ready_task_key_less au lieu
+ * de passer par les pointeurs de fonction et les void * de l'ensemble d'événements générique.
+ * Les deux versions construisent le même ordonnancement, ce qui permet de mesurer le gain.
+ *
+ * @param[in] S l'ordonnancement vide à remplir
+ * @param[in] I
+ * @param[in] preemption
+ * @param[in] cursor le curseur des libérations, ou NULL pour les ajouter toutes à E au départ
+ */
+static void fill_schedule_specialized(struct schedule_t * S, Instance I, int preemption,
+                    struct release_cursor_t * cursor) {
+    struct ready_tree_t *Q = ready_tree_new();
+    struct event_tree_t *E = event_tree_new();
+    if (cursor != NULL) {//les libérations sont lues une à une sur le curseur
+        run_events_specialized(S, E, Q, preemption, cursor);
+        ready_tree_delete(Q, NULL);
+        event_tree_delete(E, NULL);
+        return;
     }
-    while(!tree_is_empty(E)) {
-        struct tree_node_t *eventMin = tree_min(get_root(E));
-        if(get_event_type(get_tree_node_key(eventMin)) == 0) { // Si l'événement est la libération d'une tâche Tj
-            int emptyMachine = find_empty_machine(S,get_event_time(get_tree_node_key(eventMin)));
-            if(emptyMachine != -1) { // Si une machine est libre à l'instant de libération de la tâche Tj
-                struct task_t *task = (struct task_t *) get_tree_node_data(eventMin);
-                add_task_to_schedule(S, task, emptyMachine, get_event_time(get_tree_node_key(eventMin)), get_event_time(get_tree_node_key(eventMin)) + get_event_processing_time(get_tree_node_key(eventMin)));
-                
-                // Ajouter l'événement "fin d'exécution" de la tâche Tj dans l'ensemble des événements
-                struct event_key_t *endEvent = new_event_key(1, get_task_release_time(task) + get_task_processing_time(task), 0, get_task_id(task), emptyMachine);
-                tree_insert(E,endEvent,task);
-            } else if (preemption) { // Si toutes les machines sont occupées et on est en mode préemptif
-                int interMachine = find_machine_to_interrupt(S, get_event_time(eventMin->key), get_event_processing_time(eventMin));
-                if(interMachine != -1 ) {
-                    // Préempter la tâche en cours d'exécution sur la machine interMachine(//On prempt la tache)
-                    unsigned long preempt = preempt_task(S, interMachine, get_event_time(get_tree_node_key(eventMin)));
-
-                    //On supprime l'evenement de fin de E 
-                    struct schedule_node_t * sNode = get_list_node_data(get_list_tail(get_schedule_of_machine(S,interMachine)));
-                    struct task_t * tasK = get_schedule_node_task(sNode);
-                    //On va recréé la cle de l'evenement à supprimer
-                    struct event_key_t *eventKeyRemv = new_event_key(1,get_schedule_node_end_time(sNode)+preempt,0,get_task_id(tasK),interMachine);
-                    //On supprime le noued 
-                    tasK = tree_remove(E,eventKeyRemv);
-                    delete_event_key(eventKeyRemv);
-                    
-                    // Ajouter la tâche interrompue dans la file d'attente Q
-                    struct ready_task_key_t *intr_key = new_ready_task_key(preempt, get_task_id(tasK));
-                    tree_insert(Q, intr_key, tasK);
-                    // Ajouter l'événement "fin d'exécution" de la tâche Tj dans l'ensemble des événements
-                    struct event_key_t *endEvent2 = new_event_key(1, get_event_time(get_tree_node_key(eventMin)) + get_event_processing_time(get_tree_node_key(eventMin)), 0, get_task_id(get_tree_node_data(eventMin)), interMachine);
-                    tree_insert(E,endEvent2,get_tree_node_data(eventMin));
-                    // Affecter la tâche Tj à la machine interMachine
-                    add_task_to_schedule(S,get_tree_node_data(eventMin),interMachine,get_event_time(get_tree_node_key(eventMin)),get_event_time(get_tree_node_key(eventMin))+get_event_processing_time(get_tree_node_key(eventMin)));
-                } else { // On est en mode préémptif, mais on n'a pas pu faire de préemption
-                    
-                    struct ready_task_key_t *in_key = new_ready_task_key(get_task_processing_time(get_tree_node_data(eventMin)),get_task_id(get_tree_node_data(eventMin)));
-                    tree_insert(Q,in_key ,get_tree_node_data(eventMin));
-                }
-            } else { // Si toutes les machines sont occupées et on n'est pas en mode préemptif, ajouter Tj dans la file d'attente Q
-                struct ready_task_key_t *rt_key = new_ready_task_key(get_task_processing_time(get_tree_node_data(eventMin)), get_task_id(get_tree_node_data(eventMin)));
-                tree_insert(Q, rt_key, get_tree_node_data(eventMin));
-            }
-        } else { // Si l'événement est la fin d'exécution d'une tâche Tj
-            if(!tree_is_empty(Q)) { // Si la file d'attente Q n'est pas vide
-                // Extraire de Q la tâche Tk avec la durée la plus courte (règle SPT)
-                struct tree_node_t * rt_key = tree_min(get_root(Q));
-                // Affecter Tk à la machine qui vient de libérer Mi
-                add_task_to_schedule(S,get_tree_node_data(rt_key),get_event_machine(get_tree_node_key(eventMin)),get_event_time(get_tree_node_key(eventMin)),get_event_processing_time(get_tree_node_key(eventMin)));
-                // Ajouter l'événement "fin d'exécution" de la tâche Tk dans l'ensemble des événements
-                struct event_key_t *endEvent = new_event_key(1, get_event_time(get_tree_node_key(eventMin)) + get_ready_task_remaining_processing_time(get_tree_node_key(rt_key)), 0, get_task_id(get_tree_node_data(rt_key)),get_event_machine(get_tree_node_key(eventMin)));
-                tree_insert(E,endEvent,get_tree_node_data(rt_key));
-                struct task_t *task = (struct task_t *)tree_remove(Q,get_tree_node_data(rt_key));
-            }
+
+    //Ajouter les dates de libération de toutes les tâches dans E, en une fois si elles sont déjà triées
+    int n = get_list_size(I);
+    void **releaseTasks;
+    struct event_key_t *releases = new_release_events(I, &releaseTasks);
+    int sorted = 1;
+    for (int i = 1; i < n && sorted; i++) {
+        sorted = !event_key_less(&releases[i], &releases[i - 1]);
+    }
+    if (sorted) {
+        event_tree_build_from_sorted(E, releases, releaseTasks, n);
+    } else {
+        for (int i = 0; i < n; i++) {
+            event_tree_insert(E, &releases[i], releaseTasks[i]);
         }
-        // Supprimer l'événement de la fin d'exécution de Tj de l'ensemble des événements
-        struct task_t *taskk = tree_remove(E, get_tree_node_key(eventMin));
     }
-    delete_tree(Q,1,1);
-    delete_tree(E,1,1);
+    free(releases);
+    free(releaseTasks);
+
+    run_events_specialized(S, E, Q, preemption, NULL);
+    ready_tree_delete(Q, NULL);//les tâches appartiennent à l'instance
+    event_tree_delete(E, NULL);
+}
+
+/**
+ * @brief
+ * Remplir l'ordonnancement vide \p S avec les tâches de l'instance \p I (algorithme de create_schedule).
+ * Si \p cursor n'est pas NULL, les libérations sont lues une à une sur ce curseur au lieu d'être
+ * ajoutées toutes à E au départ (voir FILL_SCHEDULE_DEFINE).
+ *
+ * @param[in] S
+ * @param[in] I
+ * @param[in] preemption
+ * @param[in] balanced_tree
+ * @param[in] cursor
+ */
+static void fill_schedule(struct schedule_t * S, Instance I, int preemption, int balanced_tree,
+                    struct release_cursor_t * cursor) {
+    if (balanced_tree == 8) {//arbres spécialisés
+        fill_schedule_specialized(S, I, preemption, cursor);
+        return;
+    }
+
+    //Q et E stockent une copie de leurs clés (dans les nœuds pour les arbres) :
+    //les clés ci-dessous sont donc de simples variables locales.
+    //Leurs données sont les tâches de l'instance, libérées avec elle : Q et E ne les libèrent pas
+    //File de priorité qui contient les ready_task en file d'attente Q (un arbre, voir ready_queue_type)
+    struct event_queue_t *Q = new_event_queue(ready_queue_type(balanced_tree), sizeof(struct ready_task_key_t), ready_task_preceed, NULL, view_ready_task_key, view_task, NULL, NULL);
+    
+    //Ensemble des evenements
+    struct event_queue_t *E = new_event_queue(event_queue_type(balanced_tree), sizeof(struct event_key_t), event_preceed, event_key_time, view_event_key, view_task, NULL, NULL);
+    
+    if (cursor != NULL) {//les libérations sont lues une à une sur le curseur
+        run_events(S, E, Q, preemption, cursor);
+        delete_event_queue(Q,0,0);
+        delete_event_queue(E,0,0);
+        return;
+    }
+
+    //Ajouter les dates de libération de toutes les tâches dans l'ensemble des événements, en une fois :
+    //si l'instance est triée par date de libération, un arbre E est construit en temps linéaire
+    int n = get_list_size(I);
+    void **releaseTasks;
+    struct event_key_t *releases = new_release_events(I, &releaseTasks);
+    void **releaseKeys = malloc(n * sizeof(void *));
+    if (n > 0 && releaseKeys == NULL) {
+        ShowMessage("src.algo.c:create_schedule : allocation impossible", 1);
+    }
+    for (int i = 0; i < n; i++) {
+        releaseKeys[i] = &releases[i];
+    }
+    event_queue_insert_all(E, releaseKeys, releaseTasks, n);
+    free(releases);//E a copié les clés
+    free(releaseKeys);
+    free(releaseTasks);
+
+    run_events(S, E, Q, preemption, NULL);
+    delete_event_queue(Q,0,0);
+    delete_event_queue(E,0,0);
+}
+
+struct schedule_t * create_schedule(Instance I, int num_m, int preemption, int balanced_tree) {
+    struct schedule_t *S = new_schedule(num_m);
+    fill_schedule(S, I, preemption, balanced_tree, NULL);
+    return S;
+}
+
+struct schedule_t * create_schedule_streaming(Instance I, int num_m, int preemption, int balanced_tree,
+                        void (*sink)(void * arg, int machine, const struct task_t * task, unsigned long bt, unsigned long et),
+                        void * arg) {
+    struct schedule_t *S = new_schedule(num_m);
+    set_schedule_sink(S, sink, arg);
+    struct release_cursor_t cursor;
+    init_release_cursor(&cursor, I);
+    fill_schedule(S, I, preemption, balanced_tree, &cursor);
+    free(cursor.order);
+    flush_schedule(S);//les segments restants sont terminés
     return S;
 }
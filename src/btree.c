@@ -0,0 +1,509 @@
+#include "btree.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "util.h"
+
+/**
+ * @brief
+ * Un chemin de la racine vers une feuille d'un arbre B+ :
+ * (+) les nœuds internes traversés (nodes), de la racine (indice 0) au père de la feuille,
+ * (+) l'indice (index) du fils suivi dans chacun de ces nœuds, et
+ * (+) le nombre (height) de nœuds internes traversés.
+ * Les nœuds n'ont pas de référence vers leur père : c'est le chemin qui permet de remonter
+ * pour couper ou fusionner les nœuds.
+ */
+struct btree_path_t {
+	struct btree_node_t * nodes[BTREE_MAX_HEIGHT];
+	int index[BTREE_MAX_HEIGHT];
+	int height;
+};
+
+/********************************************************************
+ * btree_node_t
+ ********************************************************************/
+
+/**
+ * @brief
+ * Construire un nouveau nœud vide (une feuille si \p leaf vaut 1) de l'arbre B+ \p B.
+ * Le nœud est pris dans la réserve de l'arbre.
+ *
+ * @param[in] B
+ * @param[in] leaf
+ * @return struct btree_node_t*
+ */
+static struct btree_node_t * new_btree_node(struct btree_t * B, int leaf) {
+	struct btree_node_t * node = pool_alloc(B->pool);
+	node->leaf = leaf;
+	node->numkeys = 0;
+	node->next = NULL;
+	return node;
+}
+
+/**
+ * @brief Restitue l'adresse de la clé d'indice \p i du nœud \p node de l'arbre B+ \p B.
+ *
+ * @param[in] B
+ * @param[in] node
+ * @param[in] i
+ * @return char*
+ */
+static char * key_at(const struct btree_t * B, const struct btree_node_t * node, int i) {
+	return (char *) node + B->keysOffset + i * B->keySize;
+}
+
+/**
+ * @brief
+ * Recopier les \p n clés et les \p n références du nœud \p src à partir de l'indice \p si
+ * vers le nœud \p dst à partir de l'indice \p di (les deux zones peuvent se chevaucher).
+ *
+ * @param[in] B
+ * @param[in] dst
+ * @param[in] di
+ * @param[in] src
+ * @param[in] si
+ * @param[in] n
+ */
+static void move_entries(const struct btree_t * B, struct btree_node_t * dst, int di,
+						const struct btree_node_t * src, int si, int n) {
+	memmove(key_at(B, dst, di), key_at(B, src, si), n * B->keySize);
+	memmove(&dst->ptrs[di], &src->ptrs[si], n * sizeof(void *));
+}
+
+/**
+ * @brief
+ * Restitue l'indice de la première clé du nœud \p node strictement supérieure à \p key
+ * (numkeys s'il n'y en a pas) : c'est la position d'insertion après les clés égales.
+ *
+ * @param[in] B
+ * @param[in] node
+ * @param[in] key
+ * @return int
+ */
+static int upper_bound(const struct btree_t * B, const struct btree_node_t * node, const void * key) {
+	int lo = 0, hi = node->numkeys;
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		if (B->preceed(key, key_at(B, node, mid))) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+	return lo;
+}
+
+/**
+ * @brief
+ * Restitue l'indice de la première clé du nœud \p node supérieure ou égale à \p key
+ * (numkeys s'il n'y en a pas).
+ *
+ * @param[in] B
+ * @param[in] node
+ * @param[in] key
+ * @return int
+ */
+static int lower_bound(const struct btree_t * B, const struct btree_node_t * node, const void * key) {
+	int lo = 0, hi = node->numkeys;
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		if (B->preceed(key_at(B, node, mid), key)) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+/********************************************************************
+ * btree_t
+ ********************************************************************/
+
+/**
+ * NB : un nœud est alloué avec une clé et une référence de plus que capacity,
+ * pour qu'une insertion puisse d'abord remplir le nœud puis le couper en deux.
+ */
+struct btree_t * new_btree(size_t keySize, int (*preceed)(const void *, const void *),
+						void (*viewKey)(const void *), void (*viewData)(const void *),
+						void (*freeData)(void *)) {
+	assert(keySize > 0);
+	struct btree_t * B = malloc(sizeof(struct btree_t));
+	if (B == NULL) {
+		ShowMessage("src.btree.c:new_btree : allocation impossible", 1);
+	}
+	size_t header = sizeof(struct btree_node_t) + 2 * sizeof(void *) + keySize;//emplacements supplémentaires
+	int capacity = (BTREE_NODE_SIZE > header) ? (int) ((BTREE_NODE_SIZE - header) / (keySize + sizeof(void *))) : 0;
+	B->capacity = max(capacity, 3);//au moins une clé par nœud après une coupe ou une fusion
+	size_t ptrsEnd = sizeof(struct btree_node_t) + (B->capacity + 2) * sizeof(void *);
+	B->keysOffset = (ptrsEnd + sizeof(max_align_t) - 1) / sizeof(max_align_t) * sizeof(max_align_t);
+	B->keySize = keySize;
+	B->preceed = preceed;
+	B->viewKey = viewKey;
+	B->viewData = viewData;
+	B->freeData = freeData;
+	B->pool = new_pool(B->keysOffset + (B->capacity + 1) * keySize);
+	B->root = new_btree_node(B, 1);
+	B->first = B->root;//la première feuille ne change jamais : les fusions suppriment la feuille de droite
+	B->numelm = 0;
+	return B;
+}
+
+int btree_is_empty(const struct btree_t * B) {
+	return (B->numelm == 0);
+}
+
+int get_btree_size(const struct btree_t * B) {
+	return B->numelm;
+}
+
+/**
+ * NB : les données sont parcourues avec la liste des feuilles,
+ * les nœuds sont ensuite libérés en une seule fois avec la réserve de l'arbre.
+ */
+void delete_btree(struct btree_t * B, int deleteData) {
+	assert(B != NULL);
+	if (deleteData == 1 && B->freeData != NULL) {
+		for (struct btree_node_t * leaf = B->first; leaf != NULL; leaf = leaf->next) {
+			for (int i = 0; i < leaf->numkeys; i++) {
+				B->freeData(leaf->ptrs[i]);
+			}
+		}
+	}
+	delete_pool(B->pool);
+	free(B);
+}
+
+void view_btree(const struct btree_t * B) {
+	for (struct btree_node_t * leaf = B->first; leaf != NULL; leaf = leaf->next) {
+		for (int i = 0; i < leaf->numkeys; i++) {
+			if (B->viewKey != NULL) {
+				B->viewKey(key_at(B, leaf, i));
+				printf("\n");
+			}
+			if (B->viewData != NULL) {
+				B->viewData(leaf->ptrs[i]);
+				printf("\n");
+			}
+		}
+	}
+}
+
+/**
+ * @brief
+ * Couper en deux le nœud \p node de l'arbre B+ \p B, qui a une clé de trop, et restituer
+ * le nouveau nœud qui reçoit sa moitié droite. La clé qui sépare les deux nœuds est restituée
+ * par \p separator : c'est la première clé du nouveau nœud pour une feuille,
+ * la clé du milieu (qui quitte \p node mais reste en mémoire) pour un nœud interne.
+ *
+ * @param[in] B
+ * @param[in] node
+ * @param[out] separator
+ * @return struct btree_node_t*
+ */
+static struct btree_node_t * split_node(struct btree_t * B, struct btree_node_t * node, char ** separator) {
+	struct btree_node_t * right = new_btree_node(B, node->leaf);
+	int mid = node->numkeys / 2;
+	if (node->leaf) {
+		move_entries(B, right, 0, node, mid, node->numkeys - mid);
+		right->numkeys = node->numkeys - mid;
+		right->next = node->next;
+		node->next = right;
+		*separator = key_at(B, right, 0);
+	} else {//la clé du milieu remonte dans le père, ses deux fils sont partagés
+		int count = node->numkeys - mid - 1;
+		memcpy(key_at(B, right, 0), key_at(B, node, mid + 1), count * B->keySize);
+		memcpy(&right->ptrs[0], &node->ptrs[mid + 1], (count + 1) * sizeof(void *));
+		right->numkeys = count;
+		*separator = key_at(B, node, mid);
+	}
+	node->numkeys = mid;
+	return right;
+}
+
+/**
+ * NB : la feuille est cherchée en mémorisant le chemin depuis la racine,
+ * puis les nœuds trop pleins sont coupés en remontant ce chemin.
+ */
+void btree_insert(struct btree_t * B, const void * key, void * data) {
+	assert(B != NULL);
+	assert(key != NULL);
+	struct btree_path_t path;
+	path.height = 0;
+	struct btree_node_t * node = B->root;
+	while (!node->leaf) {//les clés égales sont dépassées : le nouvel élément va après elles
+		int i = upper_bound(B, node, key);
+		assert(path.height < BTREE_MAX_HEIGHT);
+		path.nodes[path.height] = node;
+		path.index[path.height] = i;
+		path.height++;
+		node = node->ptrs[i];
+	}
+	int pos = upper_bound(B, node, key);
+	move_entries(B, node, pos + 1, node, pos, node->numkeys - pos);
+	memcpy(key_at(B, node, pos), key, B->keySize);
+	node->ptrs[pos] = data;
+	node->numkeys++;
+	B->numelm++;
+	int level = path.height;
+	while (node->numkeys > B->capacity) {
+		char * separator;
+		struct btree_node_t * right = split_node(B, node, &separator);
+		if (level == 0) {//la racine est coupée : l'arbre gagne un niveau
+			struct btree_node_t * root = new_btree_node(B, 0);
+			memcpy(key_at(B, root, 0), separator, B->keySize);
+			root->ptrs[0] = node;
+			root->ptrs[1] = right;
+			root->numkeys = 1;
+			B->root = root;
+			break;
+		}
+		level--;
+		struct btree_node_t * parent = path.nodes[level];
+		int i = path.index[level];
+		memmove(key_at(B, parent, i + 1), key_at(B, parent, i), (parent->numkeys - i) * B->keySize);
+		memmove(&parent->ptrs[i + 2], &parent->ptrs[i + 1], (parent->numkeys - i) * sizeof(void *));
+		memcpy(key_at(B, parent, i), separator, B->keySize);
+		parent->ptrs[i + 1] = right;
+		parent->numkeys++;
+		node = parent;
+	}
+}
+
+void * get_btree_min_key(const struct btree_t * B) {
+	assert(!btree_is_empty(B));
+	return key_at(B, B->first, 0);
+}
+
+void * get_btree_min_data(const struct btree_t * B) {
+	assert(!btree_is_empty(B));
+	return B->first->ptrs[0];
+}
+
+/**
+ * @brief
+ * Chercher dans l'arbre B+ \p B le premier élément de clé égale à \p key.
+ * Restitue 1 s'il existe, avec sa feuille \p leaf, sa position \p pos dans la feuille
+ * et le chemin \p path de la racine à la feuille ; restitue 0 sinon.
+ * Tous les éléments des fils qui précèdent le fils suivi sont strictement inférieurs à \p key ;
+ * si la feuille atteinte ne contient que des clés inférieures, le premier élément supérieur ou égal
+ * est au début de la feuille suivante, que l'on atteint en corrigeant le chemin.
+ *
+ * @param[in] B
+ * @param[in] key
+ * @param[out] path
+ * @param[out] leaf
+ * @param[out] pos
+ * @return int
+ */
+static int find_first(const struct btree_t * B, const void * key, struct btree_path_t * path,
+					struct btree_node_t ** leaf, int * pos) {
+	path->height = 0;
+	struct btree_node_t * node = B->root;
+	while (!node->leaf) {
+		int i = lower_bound(B, node, key);
+		path->nodes[path->height] = node;
+		path->index[path->height] = i;
+		path->height++;
+		node = node->ptrs[i];
+	}
+	int p = lower_bound(B, node, key);
+	if (p == node->numkeys) {//on passe à la feuille suivante en remontant jusqu'au premier fils qui a un frère droit
+		int level = path->height - 1;
+		while (level >= 0 && path->index[level] == path->nodes[level]->numkeys) {
+			level--;
+		}
+		if (level < 0) {
+			return 0;
+		}
+		path->index[level]++;
+		node = path->nodes[level]->ptrs[path->index[level]];
+		for (level++; level < path->height; level++) {
+			path->nodes[level] = node;
+			path->index[level] = 0;
+			node = node->ptrs[0];
+		}
+		p = 0;
+	}
+	if (B->preceed(key, key_at(B, node, p))) {//la première clé supérieure ou égale est strictement supérieure
+		return 0;
+	}
+	*leaf = node;
+	*pos = p;
+	return 1;
+}
+
+void * btree_find(const struct btree_t * B, const void * key) {
+	struct btree_path_t path;
+	struct btree_node_t * leaf;
+	int pos;
+	return find_first(B, key, &path, &leaf, &pos) ? leaf->ptrs[pos] : NULL;
+}
+
+/**
+ * @brief
+ * Déplacer vers le nœud \p node, fils d'indice \p i du nœud \p parent, la dernière clé de son frère gauche \p left.
+ * Pour des nœuds internes, la clé passe par le père (rotation).
+ *
+ * @param[in] B
+ * @param[in] parent
+ * @param[in] i
+ * @param[in] left
+ * @param[in] node
+ */
+static void borrow_from_left(struct btree_t * B, struct btree_node_t * parent, int i,
+							struct btree_node_t * left, struct btree_node_t * node) {
+	if (node->leaf) {
+		move_entries(B, node, 1, node, 0, node->numkeys);
+		move_entries(B, node, 0, left, left->numkeys - 1, 1);
+		memcpy(key_at(B, parent, i - 1), key_at(B, node, 0), B->keySize);
+	} else {
+		memmove(key_at(B, node, 1), key_at(B, node, 0), node->numkeys * B->keySize);
+		memmove(&node->ptrs[1], &node->ptrs[0], (node->numkeys + 1) * sizeof(void *));
+		memcpy(key_at(B, node, 0), key_at(B, parent, i - 1), B->keySize);
+		node->ptrs[0] = left->ptrs[left->numkeys];
+		memcpy(key_at(B, parent, i - 1), key_at(B, left, left->numkeys - 1), B->keySize);
+	}
+	left->numkeys--;
+	node->numkeys++;
+}
+
+/**
+ * @brief
+ * Déplacer vers le nœud \p node, fils d'indice \p i du nœud \p parent, la première clé de son frère droit \p right
+ * (symétrique de borrow_from_left).
+ *
+ * @param[in] B
+ * @param[in] parent
+ * @param[in] i
+ * @param[in] node
+ * @param[in] right
+ */
+static void borrow_from_right(struct btree_t * B, struct btree_node_t * parent, int i,
+							struct btree_node_t * node, struct btree_node_t * right) {
+	if (node->leaf) {
+		move_entries(B, node, node->numkeys, right, 0, 1);
+		move_entries(B, right, 0, right, 1, right->numkeys - 1);
+		memcpy(key_at(B, parent, i), key_at(B, right, 0), B->keySize);
+	} else {
+		memcpy(key_at(B, node, node->numkeys), key_at(B, parent, i), B->keySize);
+		node->ptrs[node->numkeys + 1] = right->ptrs[0];
+		memcpy(key_at(B, parent, i), key_at(B, right, 0), B->keySize);
+		memmove(key_at(B, right, 0), key_at(B, right, 1), (right->numkeys - 1) * B->keySize);
+		memmove(&right->ptrs[0], &right->ptrs[1], right->numkeys * sizeof(void *));
+	}
+	node->numkeys++;
+	right->numkeys--;
+}
+
+/**
+ * @brief
+ * Fusionner le nœud \p right dans son frère gauche \p left, fils d'indices \p s et s+1 du nœud \p parent,
+ * puis retirer du père la clé d'indice \p s qui les séparait (elle descend dans \p left pour des nœuds internes).
+ * Le nœud \p right est rendu à la réserve.
+ *
+ * @param[in] B
+ * @param[in] parent
+ * @param[in] s
+ * @param[in] left
+ * @param[in] right
+ */
+static void merge_nodes(struct btree_t * B, struct btree_node_t * parent, int s,
+						struct btree_node_t * left, struct btree_node_t * right) {
+	if (left->leaf) {
+		move_entries(B, left, left->numkeys, right, 0, right->numkeys);
+		left->numkeys += right->numkeys;
+		left->next = right->next;
+	} else {
+		memcpy(key_at(B, left, left->numkeys), key_at(B, parent, s), B->keySize);
+		memcpy(key_at(B, left, left->numkeys + 1), key_at(B, right, 0), right->numkeys * B->keySize);
+		memcpy(&left->ptrs[left->numkeys + 1], &right->ptrs[0], (right->numkeys + 1) * sizeof(void *));
+		left->numkeys += right->numkeys + 1;
+	}
+	memmove(key_at(B, parent, s), key_at(B, parent, s + 1), (parent->numkeys - s - 1) * B->keySize);
+	memmove(&parent->ptrs[s + 1], &parent->ptrs[s + 2], (parent->numkeys - s - 1) * sizeof(void *));
+	parent->numkeys--;
+	pool_free(B->pool, right);
+}
+
+/**
+ * @brief
+ * Supprimer l'élément d'indice \p pos de la feuille \p leaf de l'arbre B+ \p B, atteinte par le chemin \p path,
+ * et restituer sa donnée. Tant qu'un nœud a moins de capacity/2 clés, il emprunte une clé à un frère
+ * qui en a plus, sinon il fusionne avec un frère et le problème remonte au père.
+ * Si la racine interne n'a plus de clé, son unique fils devient la racine.
+ *
+ * @param[in] B
+ * @param[in] path
+ * @param[in] leaf
+ * @param[in] pos
+ * @return void*
+ */
+static void * remove_at(struct btree_t * B, struct btree_path_t * path, struct btree_node_t * leaf, int pos) {
+	void * data = leaf->ptrs[pos];
+	move_entries(B, leaf, pos, leaf, pos + 1, leaf->numkeys - pos - 1);
+	leaf->numkeys--;
+	B->numelm--;
+	int minKeys = B->capacity / 2;
+	struct btree_node_t * node = leaf;
+	for (int level = path->height - 1; level >= 0 && node->numkeys < minKeys; level--) {
+		struct btree_node_t * parent = path->nodes[level];
+		int i = path->index[level];
+		struct btree_node_t * left = (i > 0) ? parent->ptrs[i - 1] : NULL;
+		struct btree_node_t * right = (i < parent->numkeys) ? parent->ptrs[i + 1] : NULL;
+		if (left != NULL && left->numkeys > minKeys) {
+			borrow_from_left(B, parent, i, left, node);
+			break;
+		}
+		if (right != NULL && right->numkeys > minKeys) {
+			borrow_from_right(B, parent, i, node, right);
+			break;
+		}
+		if (left != NULL) {
+			merge_nodes(B, parent, i - 1, left, node);
+		} else {
+			merge_nodes(B, parent, i, node, right);
+		}
+		node = parent;
+	}
+	if (!B->root->leaf && B->root->numkeys == 0) {//l'arbre perd un niveau
+		struct btree_node_t * root = B->root;
+		B->root = root->ptrs[0];
+		pool_free(B->pool, root);
+	}
+	return data;
+}
+
+/**
+ * NB : l'élément est cherché avec find_first puis supprimé avec remove_at.
+ */
+void * btree_remove(struct btree_t * B, const void * key) {
+	assert(B != NULL);
+	struct btree_path_t path;
+	struct btree_node_t * leaf;
+	int pos;
+	if (!find_first(B, key, &path, &leaf, &pos)) {
+		return NULL;
+	}
+	return remove_at(B, &path, leaf, pos);
+}
+
+/**
+ * NB : le chemin vers le minimum suit toujours le premier fils.
+ */
+void * btree_pop_min(struct btree_t * B) {
+	assert(!btree_is_empty(B));
+	struct btree_path_t path;
+	path.height = 0;
+	struct btree_node_t * node = B->root;
+	while (!node->leaf) {
+		path.nodes[path.height] = node;
+		path.index[path.height] = 0;
+		path.height++;
+		node = node->ptrs[0];
+	}
+	return remove_at(B, &path, node, 0);
+}
@@ -0,0 +1,395 @@
+#include "calendar_queue.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "util.h"
+#include "heap.h"
+
+/********************************************************************
+ * calendar_bucket_t
+ ********************************************************************/
+
+/**
+ * @brief
+ * Insérer l'élément \p node dans le seau trié \p B (ordre de heap_node_preceed :
+ * un élément passe après les éléments de clé égale insérés avant lui).
+ * Si l'élément devient le premier du seau et qu'il y a de la place devant, aucun décalage n'est fait.
+ *
+ * @param[in] B
+ * @param[in] node
+ * @param[in] preceed
+ */
+static void bucket_insert(struct calendar_bucket_t * B, struct heap_node_t node,
+						int (*preceed)(const void *, const void *)) {
+	int lo = B->first, hi = B->first + B->numelm;
+	while (lo < hi) {//premier élément strictement après node
+		int mid = lo + (hi - lo) / 2;
+		if (heap_node_preceed(preceed, &node, &B->nodes[mid])) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+	if (lo == B->first && B->first > 0) {
+		B->nodes[--B->first] = node;
+		B->numelm++;
+		return;
+	}
+	if (B->first + B->numelm == B->capacity) {
+		if (B->first > 0) {//on récupère la place libérée par les extractions
+			memmove(B->nodes, B->nodes + B->first, B->numelm * sizeof(struct heap_node_t));
+			lo -= B->first;
+			B->first = 0;
+		} else {
+			int capacity = (B->capacity == 0) ? 4 : 2 * B->capacity;
+			struct heap_node_t * nodes = realloc(B->nodes, capacity * sizeof(struct heap_node_t));
+			if (nodes == NULL) {
+				ShowMessage("src.calendar_queue.c:bucket_insert : allocation impossible", 1);
+			}
+			B->nodes = nodes;
+			B->capacity = capacity;
+		}
+	}
+	memmove(&B->nodes[lo + 1], &B->nodes[lo], (B->first + B->numelm - lo) * sizeof(struct heap_node_t));
+	B->nodes[lo] = node;
+	B->numelm++;
+}
+
+/**
+ * @brief Retirer et restituer l'élément d'indice \p i du seau \p B.
+ *
+ * @param[in] B
+ * @param[in] i
+ * @return struct heap_node_t
+ */
+static struct heap_node_t bucket_remove_at(struct calendar_bucket_t * B, int i) {
+	struct heap_node_t removed = B->nodes[i];
+	if (i == B->first) {//cas de l'extraction du minimum : pas de décalage
+		B->first++;
+	} else {
+		memmove(&B->nodes[i], &B->nodes[i + 1], (B->first + B->numelm - i - 1) * sizeof(struct heap_node_t));
+	}
+	B->numelm--;
+	if (B->numelm == 0) {
+		B->first = 0;
+	}
+	return removed;
+}
+
+/********************************************************************
+ * calendar_queue_t
+ ********************************************************************/
+
+/**
+ * @brief Restitue l'indice du seau des clés de date \p t.
+ *
+ * @param[in] C
+ * @param[in] t
+ * @return int
+ */
+static inline int bucket_of(const struct calendar_queue_t * C, unsigned long t) {
+	return (int) ((t / C->width) % C->nbuckets);
+}
+
+/**
+ * @brief Placer le seau courant de la file \p C sur le jour de la date \p t.
+ *
+ * @param[in] C
+ * @param[in] t
+ */
+static void set_current(struct calendar_queue_t * C, unsigned long t) {
+	C->lastprio = t;
+	C->lastbucket = bucket_of(C, t);
+	C->buckettop = (t / C->width + 1) * C->width;
+}
+
+struct calendar_queue_t * new_calendar_queue(unsigned long (*time)(const void *),
+						int (*preceed)(const void *, const void *),
+						void (*viewKey)(const void *), void (*viewData)(const void *),
+						void (*freeKey)(void *), void (*freeData)(void *)) {
+	assert(time != NULL);
+	struct calendar_queue_t * C = malloc(sizeof(struct calendar_queue_t));
+	if (C == NULL) {
+		ShowMessage("src.calendar_queue.c:new_calendar_queue : allocation impossible", 1);
+	}
+	C->nbuckets = CALENDAR_MIN_BUCKETS;
+	C->buckets = calloc(C->nbuckets, sizeof(struct calendar_bucket_t));
+	if (C->buckets == NULL) {
+		ShowMessage("src.calendar_queue.c:new_calendar_queue : allocation impossible", 1);
+	}
+	C->width = 1;
+	C->numelm = 0;
+	C->resizable = 1;
+	C->seq = 0;
+	C->time = time;
+	C->preceed = preceed;
+	C->viewKey = viewKey;
+	C->viewData = viewData;
+	C->freeKey = freeKey;
+	C->freeData = freeData;
+	set_current(C, 0);
+	return C;
+}
+
+int calendar_queue_is_empty(const struct calendar_queue_t * C) {
+	return (C->numelm == 0);
+}
+
+int get_calendar_queue_size(const struct calendar_queue_t * C) {
+	return C->numelm;
+}
+
+void delete_calendar_queue(struct calendar_queue_t * C, int deleteKey, int deleteData) {
+	assert(C != NULL);
+	for (int i = 0; i < C->nbuckets; i++) {
+		struct calendar_bucket_t * B = &C->buckets[i];
+		for (int j = B->first; j < B->first + B->numelm; j++) {
+			if (deleteKey == 1 && C->freeKey != NULL) {
+				C->freeKey(B->nodes[j].key);
+			}
+			if (deleteData == 1 && C->freeData != NULL) {
+				C->freeData(B->nodes[j].data);
+			}
+		}
+		free(B->nodes);
+	}
+	free(C->buckets);
+	free(C);
+}
+
+void view_calendar_queue(const struct calendar_queue_t * C) {
+	for (int i = 0; i < C->nbuckets; i++) {
+		struct calendar_bucket_t * B = &C->buckets[i];
+		for (int j = B->first; j < B->first + B->numelm; j++) {
+			if (C->viewKey != NULL) {
+				C->viewKey(B->nodes[j].key);
+				printf("\n");
+			}
+			if (C->viewData != NULL) {
+				C->viewData(B->nodes[j].data);
+				printf("\n");
+			}
+		}
+	}
+}
+
+/**
+ * @brief
+ * Trouver le seau qui contient le minimum de la file non vide \p C.
+ * On parcourt les seaux à partir du seau courant pendant au plus une année :
+ * le premier seau dont la tête tombe dans l'intervalle du jour courant contient le minimum.
+ * Si l'année est vide (événements très espacés), on cherche directement la plus petite tête.
+ *
+ * @param[in] C
+ * @return int
+ */
+static int find_min_bucket(struct calendar_queue_t * C) {
+	int i = C->lastbucket;
+	unsigned long top = C->buckettop;
+	for (int k = 0; k < C->nbuckets; k++) {
+		struct calendar_bucket_t * B = &C->buckets[i];
+		if (B->numelm > 0 && C->time(B->nodes[B->first].key) < top) {
+			C->lastbucket = i;
+			C->buckettop = top;
+			return i;
+		}
+		if (++i == C->nbuckets) {
+			i = 0;
+		}
+		top += C->width;
+	}
+	int best = -1;//recherche directe
+	for (i = 0; i < C->nbuckets; i++) {
+		struct calendar_bucket_t * B = &C->buckets[i];
+		if (B->numelm > 0 && (best == -1 ||
+				C->preceed(B->nodes[B->first].key, C->buckets[best].nodes[C->buckets[best].first].key))) {
+			best = i;
+		}
+	}
+	assert(best != -1);
+	set_current(C, C->time(C->buckets[best].nodes[C->buckets[best].first].key));
+	return best;
+}
+
+static void insert_node(struct calendar_queue_t * C, struct heap_node_t node);
+static struct heap_node_t remove_min_node(struct calendar_queue_t * C);
+
+/**
+ * @brief
+ * Estimer une nouvelle largeur de seau pour la file \p C : on extrait temporairement
+ * les CALENDAR_SAMPLE_SIZE premières clés, on calcule l'écart moyen entre deux dates consécutives
+ * en ignorant les écarts plus grands que deux fois la moyenne, et la largeur vaut trois fois cet écart.
+ * Les clés extraites sont ensuite réinsérées. Le redimensionnement doit être désactivé.
+ *
+ * @param[in] C
+ * @return unsigned long
+ */
+static unsigned long sample_width(struct calendar_queue_t * C) {
+	int n = min(C->numelm, CALENDAR_SAMPLE_SIZE);
+	if (n < 2) {
+		return C->width;
+	}
+	struct heap_node_t sample[CALENDAR_SAMPLE_SIZE];
+	unsigned long t[CALENDAR_SAMPLE_SIZE];
+	unsigned long lastprio = C->lastprio;
+	for (int i = 0; i < n; i++) {//les éléments gardent leur numéro d'insertion
+		sample[i] = remove_min_node(C);
+		t[i] = C->time(sample[i].key);
+	}
+	for (int i = 0; i < n; i++) {
+		insert_node(C, sample[i]);
+	}
+	set_current(C, lastprio);
+	double avg = (double) (t[n - 1] - t[0]) / (n - 1);
+	if (avg == 0) {//dates toutes égales : pas d'information sur l'espacement
+		return C->width;
+	}
+	double sum = 0;
+	int count = 0;
+	for (int i = 1; i < n; i++) {
+		unsigned long sep = t[i] - t[i - 1];
+		if (sep <= 2 * avg) {
+			sum += sep;
+			count++;
+		}
+	}
+	unsigned long width = (unsigned long) (3 * sum / count);
+	return (width == 0) ? 1 : width;
+}
+
+/**
+ * @brief
+ * Redimensionner la file \p C avec \p nbuckets seaux et une largeur réestimée,
+ * puis y ranger à nouveau tous ses éléments.
+ *
+ * @param[in] C
+ * @param[in] nbuckets
+ */
+static void resize(struct calendar_queue_t * C, int nbuckets) {
+	C->resizable = 0;//pas de redimensionnement pendant l'échantillonnage
+	unsigned long width = sample_width(C);
+	struct calendar_bucket_t * old = C->buckets;
+	int oldn = C->nbuckets;
+	C->buckets = calloc(nbuckets, sizeof(struct calendar_bucket_t));
+	if (C->buckets == NULL) {
+		ShowMessage("src.calendar_queue.c:resize : allocation impossible", 1);
+	}
+	C->nbuckets = nbuckets;
+	C->width = width;
+	for (int i = 0; i < oldn; i++) {
+		for (int j = old[i].first; j < old[i].first + old[i].numelm; j++) {
+			bucket_insert(&C->buckets[bucket_of(C, C->time(old[i].nodes[j].key))], old[i].nodes[j], C->preceed);
+		}
+		free(old[i].nodes);
+	}
+	free(old);
+	set_current(C, C->lastprio);
+	C->resizable = 1;
+}
+
+/**
+ * @brief Ajouter dans la file \p C l'élément \p node, en conservant son numéro d'insertion.
+ *
+ * @param[in] C
+ * @param[in] node
+ */
+static void insert_node(struct calendar_queue_t * C, struct heap_node_t node) {
+	unsigned long t = C->time(node.key);
+	if (t < C->lastprio) {//clé dans le passé : on revient en arrière pour ne pas la manquer
+		set_current(C, t);
+	}
+	bucket_insert(&C->buckets[bucket_of(C, t)], node, C->preceed);
+	C->numelm++;
+	if (C->resizable && C->numelm > 2 * C->nbuckets) {
+		resize(C, 2 * C->nbuckets);
+	}
+}
+
+void calendar_queue_insert(struct calendar_queue_t * C, void * key, void * data) {
+	assert(C != NULL);
+	struct heap_node_t node = { key, data, C->seq++, NULL };
+	insert_node(C, node);
+}
+
+struct heap_node_t * calendar_queue_min(struct calendar_queue_t * C) {
+	assert(!calendar_queue_is_empty(C));
+	struct calendar_bucket_t * B = &C->buckets[find_min_bucket(C)];
+	return &B->nodes[B->first];
+}
+
+/**
+ * @brief Retirer et restituer l'élément de clé minimum de la file non vide \p C.
+ *
+ * @param[in] C
+ * @return struct heap_node_t
+ */
+static struct heap_node_t remove_min_node(struct calendar_queue_t * C) {
+	struct calendar_bucket_t * B = &C->buckets[find_min_bucket(C)];
+	struct heap_node_t removed = bucket_remove_at(B, B->first);
+	C->lastprio = C->time(removed.key);
+	C->numelm--;
+	if (C->resizable && C->nbuckets > CALENDAR_MIN_BUCKETS && C->numelm < C->nbuckets / 2) {
+		resize(C, C->nbuckets / 2);
+	}
+	return removed;
+}
+
+void * calendar_queue_remove_min(struct calendar_queue_t * C, void ** key) {
+	assert(!calendar_queue_is_empty(C));
+	struct heap_node_t removed = remove_min_node(C);
+	if (key != NULL) {
+		*key = removed.key;
+	} else if (C->freeKey != NULL) {
+		C->freeKey(removed.key);
+	}
+	return removed.data;
+}
+
+/**
+ * @brief
+ * Retirer de la file calendrier \p C l'élément de clé égale à \p key, ou, si \p identity vaut 1,
+ * l'élément dont la clé est \p key elle-même : les clés égales sont consécutives dans le seau,
+ * on les parcourt à partir de la première (voir calendar_queue_remove et calendar_queue_remove_handle).
+ *
+ * @param[in] C
+ * @param[in] key
+ * @param[in] identity
+ * @return void*
+ */
+static void * remove_matching(struct calendar_queue_t * C, void * key, int identity) {
+	assert(C != NULL);
+	struct calendar_bucket_t * B = &C->buckets[bucket_of(C, C->time(key))];
+	int lo = B->first, hi = B->first + B->numelm;
+	while (lo < hi) {//premier élément qui n'est pas avant key
+		int mid = lo + (hi - lo) / 2;
+		if (C->preceed(B->nodes[mid].key, key)) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	while (identity && lo < B->first + B->numelm && B->nodes[lo].key != key
+			&& !C->preceed(key, B->nodes[lo].key)) {
+		lo++;
+	}
+	if (lo == B->first + B->numelm || C->preceed(key, B->nodes[lo].key)) {
+		return NULL;
+	}
+	struct heap_node_t removed = bucket_remove_at(B, lo);
+	C->numelm--;
+	if (C->freeKey != NULL) {
+		C->freeKey(removed.key);
+	}
+	return removed.data;
+}
+
+void * calendar_queue_remove(struct calendar_queue_t * C, void * key) {
+	return remove_matching(C, key, 0);
+}
+
+void * calendar_queue_remove_handle(struct calendar_queue_t * C, void * handle) {
+	return remove_matching(C, handle, 1);
+}
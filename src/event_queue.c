@@ -0,0 +1,581 @@
+#include "event_queue.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "util.h"
+#include "tree.h"
+#include "heap.h"
+#include "radix_heap.h"
+#include "calendar_queue.h"
+#include "btree.h"
+#include "pool.h"
+
+/********************************************************************
+ * Flot trié (EVENT_QUEUE_STREAM)
+ ********************************************************************/
+
+/**
+ * @brief
+ * Trier les \p n éléments du tableau \p nodes par ordre croissant de clé (tri fusion stable).
+ * Si le tableau est déjà trié, il n'est parcouru qu'une fois.
+ *
+ * @param[in] nodes
+ * @param[in] n
+ * @param[in] preceed
+ */
+static void sort_stream(struct heap_node_t * nodes, int n, int (*preceed)(const void *, const void *)) {
+	int sorted = 1;
+	for (int i = 1; i < n && sorted; i++) {//cas fréquent d'une instance déjà triée
+		sorted = !preceed(nodes[i].key, nodes[i - 1].key);
+	}
+	if (sorted) {
+		return;
+	}
+	struct heap_node_t * tmp = malloc(n * sizeof(struct heap_node_t));
+	if (tmp == NULL) {
+		ShowMessage("src.event_queue.c:sort_stream : allocation impossible", 1);
+	}
+	struct heap_node_t * src = nodes, * dst = tmp;
+	for (int width = 1; width < n; width *= 2) {//fusion des séquences triées de taille width
+		for (int lo = 0; lo < n; lo += 2 * width) {
+			int mid = min(lo + width, n), hi = min(lo + 2 * width, n);
+			int i = lo, j = mid, k = lo;
+			while (i < mid && j < hi) {
+				dst[k++] = preceed(src[j].key, src[i].key) ? src[j++] : src[i++];
+			}
+			while (i < mid) {
+				dst[k++] = src[i++];
+			}
+			while (j < hi) {
+				dst[k++] = src[j++];
+			}
+		}
+		struct heap_node_t * swap = src;
+		src = dst;
+		dst = swap;
+	}
+	if (src != nodes) {
+		memcpy(nodes, src, n * sizeof(struct heap_node_t));
+	}
+	free(tmp);
+}
+
+/**
+ * @brief
+ * Rendre la clé \p key d'un événement retiré du flot de l'ensemble \p EQ :
+ * à la réserve des copies si l'ensemble copie ses clés, sinon avec freeKey.
+ *
+ * @param[in] EQ
+ * @param[in] key
+ */
+static void release_stream_key(struct event_queue_t * EQ, void * key) {
+	if (EQ->keys != NULL) {
+		pool_free(EQ->keys, key);
+	} else if (EQ->freeKey != NULL) {
+		EQ->freeKey(key);
+	}
+}
+
+/**
+ * @brief
+ * Avancer le curseur du flot de l'ensemble \p EQ au-delà des événements retirés
+ * (voir stream_remove_at) : la tête du flot est toujours un événement présent.
+ *
+ * @param[in] EQ
+ */
+static void skip_stream_removed(struct event_queue_t * EQ) {
+	while (EQ->cursor < EQ->stream_size && EQ->stream[EQ->cursor].handle == NULL) {
+		release_stream_key(EQ, EQ->stream[EQ->cursor].key);
+		EQ->stream_removed--;
+		EQ->cursor++;
+	}
+}
+
+/**
+ * @brief
+ * Fermer le flot de l'ensemble \p EQ s'il est encore ouvert :
+ * le flot est trié, la référence de chaque élément reçoit sa position,
+ * et les insertions suivantes iront dans le tas.
+ *
+ * @param[in] EQ
+ */
+static void close_stream(struct event_queue_t * EQ) {
+	if (EQ->streaming) {
+		sort_stream(EQ->stream, EQ->stream_size, EQ->preceed);
+		for (int i = 0; i < EQ->stream_size; i++) {
+			EQ->stream[i].handle->index = i;
+		}
+		EQ->streaming = 0;
+	}
+}
+
+/**
+ * @brief
+ * Renvoie 1 si le prochain événement de l'ensemble \p EQ est la tête du flot,
+ * 0 s'il est au sommet du tas. Le flot doit être fermé.
+ *
+ * @param[in] EQ
+ * @return int
+ */
+static int stream_is_next(const struct event_queue_t * EQ) {
+	if (EQ->cursor == EQ->stream_size) {
+		return 0;
+	}
+	if (heap_is_empty(EQ->heap)) {
+		return 1;
+	}
+	return !EQ->preceed(heap_min(EQ->heap)->key, EQ->stream[EQ->cursor].key);
+}
+
+/**
+ * @brief
+ * Retirer l'événement d'indice \p i du flot fermé de l'ensemble \p EQ et restituer sa donnée.
+ * Le flot n'est pas décalé : l'élément est seulement marqué comme retiré (sa référence vaut NULL)
+ * et sa clé, qui sert encore aux recherches dichotomiques, est rendue quand le curseur le dépasse.
+ *
+ * @param[in] EQ
+ * @param[in] i
+ * @return void*
+ */
+static void * stream_remove_at(struct event_queue_t * EQ, int i) {
+	assert(i >= EQ->cursor && i < EQ->stream_size && EQ->stream[i].handle != NULL);
+	pool_free(EQ->heap->handles, EQ->stream[i].handle);
+	EQ->stream[i].handle = NULL;
+	EQ->stream_removed++;
+	skip_stream_removed(EQ);
+	return EQ->stream[i].data;
+}
+
+/**
+ * @brief
+ * Retirer du flot fermé de l'ensemble \p EQ un événement de clé égale à \p key et restituer sa donnée.
+ * L'événement doit être dans le flot : recherche dichotomique de la première clé égale,
+ * puis parcours des clés égales jusqu'à un événement qui n'a pas déjà été retiré.
+ *
+ * @param[in] EQ
+ * @param[in] key
+ * @return void*
+ */
+static void * stream_remove(struct event_queue_t * EQ, void * key) {
+	int lo = EQ->cursor, hi = EQ->stream_size;
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		if (EQ->preceed(EQ->stream[mid].key, key)) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	while (lo < EQ->stream_size && EQ->stream[lo].handle == NULL) {//les clés égales sont consécutives
+		lo++;
+	}
+	assert(lo < EQ->stream_size && !EQ->preceed(key, EQ->stream[lo].key));
+	return stream_remove_at(EQ, lo);
+}
+
+/********************************************************************
+ * event_queue_t
+ ********************************************************************/
+
+struct event_queue_t * new_event_queue(int type, size_t keySize, int (*preceed)(const void *, const void *),
+						unsigned long (*time)(const void *),
+						void (*viewKey)(const void *), void (*viewData)(const void *),
+						void (*freeKey)(void *), void (*freeData)(void *)) {
+	struct event_queue_t * EQ = malloc(sizeof(struct event_queue_t));
+	if (EQ == NULL) {
+		ShowMessage("src.event_queue.c:new_event_queue : allocation impossible", 1);
+	}
+	EQ->type = type;
+	EQ->tree = NULL;
+	EQ->heap = NULL;
+	EQ->stream = NULL;
+	EQ->stream_size = 0;
+	EQ->stream_capacity = 0;
+	EQ->cursor = 0;
+	EQ->stream_removed = 0;
+	EQ->streaming = (type == EVENT_QUEUE_STREAM);
+	EQ->radix = NULL;
+	EQ->calendar = NULL;
+	EQ->btree = NULL;
+	EQ->keySize = keySize;
+	EQ->keys = NULL;
+	if (keySize > 0) {//l'ensemble possède les copies des clés : elles ne sont jamais libérées avec freeKey
+		freeKey = NULL;
+		if (type != EVENT_QUEUE_BST && type != EVENT_QUEUE_AVL && type != EVENT_QUEUE_RBT && type != EVENT_QUEUE_BTREE) {
+			EQ->keys = new_pool(keySize);
+		}
+	}
+	EQ->preceed = preceed;
+	EQ->freeKey = freeKey;
+	EQ->freeData = freeData;
+	switch (type) {
+		case EVENT_QUEUE_BST:
+		case EVENT_QUEUE_AVL:
+		case EVENT_QUEUE_RBT: {
+			int balanced = (type == EVENT_QUEUE_RBT) ? TREE_RED_BLACK : type;//EVENT_QUEUE_BST et EVENT_QUEUE_AVL valent TREE_BST et TREE_AVL
+			if (keySize > 0) {
+				EQ->tree = new_tree_by_value(balanced, keySize, preceed, viewKey, viewData, freeData);
+			} else {
+				EQ->tree = new_tree(balanced, preceed, viewKey, viewData, freeKey, freeData);
+			}
+			break;
+		}
+		case EVENT_QUEUE_HEAP:
+		case EVENT_QUEUE_STREAM:
+			EQ->heap = new_heap(HEAP_DEFAULT_ARITY, preceed, viewKey, viewData, freeKey, freeData);
+			break;
+		case EVENT_QUEUE_RADIX:
+			EQ->radix = new_radix_heap(time, preceed, viewKey, viewData, freeKey, freeData);
+			break;
+		case EVENT_QUEUE_CALENDAR:
+			EQ->calendar = new_calendar_queue(time, preceed, viewKey, viewData, freeKey, freeData);
+			break;
+		case EVENT_QUEUE_BTREE:
+			if (keySize == 0) {
+				ShowMessage("src.event_queue.c:new_event_queue : un arbre B+ stocke ses clés par valeur (keySize nul)", 1);
+			}
+			EQ->btree = new_btree(keySize, preceed, viewKey, viewData, freeData);
+			break;
+		default:
+			ShowMessage("src.event_queue.c:new_event_queue : type d'ensemble d'événements inconnu", 1);
+	}
+	return EQ;
+}
+
+int event_queue_is_empty(const struct event_queue_t * EQ) {
+	return (get_event_queue_size(EQ) == 0);
+}
+
+int get_event_queue_size(const struct event_queue_t * EQ) {
+	switch (EQ->type) {
+		case EVENT_QUEUE_BST:
+		case EVENT_QUEUE_AVL:
+		case EVENT_QUEUE_RBT:
+			return get_tree_size(EQ->tree);
+		case EVENT_QUEUE_STREAM:
+			return (EQ->stream_size - EQ->cursor - EQ->stream_removed) + get_heap_size(EQ->heap);
+		case EVENT_QUEUE_RADIX:
+			return get_radix_heap_size(EQ->radix);
+		case EVENT_QUEUE_CALENDAR:
+			return get_calendar_queue_size(EQ->calendar);
+		case EVENT_QUEUE_BTREE:
+			return get_btree_size(EQ->btree);
+		default:
+			return get_heap_size(EQ->heap);
+	}
+}
+
+void delete_event_queue(struct event_queue_t * EQ, int deleteKey, int deleteData) {
+	assert(EQ != NULL);
+	switch (EQ->type) {
+		case EVENT_QUEUE_BST:
+		case EVENT_QUEUE_AVL:
+		case EVENT_QUEUE_RBT:
+			delete_tree(EQ->tree, deleteKey, deleteData);
+			break;
+		case EVENT_QUEUE_STREAM:
+			for (int i = EQ->cursor; i < EQ->stream_size; i++) {//les éléments pas encore extraits du flot
+				if (EQ->stream[i].handle == NULL) {//élément déjà retiré : seule sa clé restait à rendre
+					if (EQ->freeKey != NULL) {
+						EQ->freeKey(EQ->stream[i].key);
+					}
+					continue;
+				}
+				if (deleteKey == 1 && EQ->freeKey != NULL) {
+					EQ->freeKey(EQ->stream[i].key);
+				}
+				if (deleteData == 1 && EQ->freeData != NULL) {
+					EQ->freeData(EQ->stream[i].data);
+				}
+			}
+			free(EQ->stream);
+			delete_heap(EQ->heap, deleteKey, deleteData);
+			break;
+		case EVENT_QUEUE_RADIX:
+			delete_radix_heap(EQ->radix, deleteKey, deleteData);
+			break;
+		case EVENT_QUEUE_CALENDAR:
+			delete_calendar_queue(EQ->calendar, deleteKey, deleteData);
+			break;
+		case EVENT_QUEUE_BTREE:
+			delete_btree(EQ->btree, deleteData);
+			break;
+		default:
+			delete_heap(EQ->heap, deleteKey, deleteData);
+	}
+	if (EQ->keys != NULL) {
+		delete_pool(EQ->keys);
+	}
+	free(EQ);
+}
+
+void view_event_queue(const struct event_queue_t * EQ) {
+	switch (EQ->type) {
+		case EVENT_QUEUE_BST:
+		case EVENT_QUEUE_AVL:
+		case EVENT_QUEUE_RBT:
+			view_tree(EQ->tree);
+			break;
+		case EVENT_QUEUE_STREAM:
+			for (int i = EQ->cursor; i < EQ->stream_size; i++) {
+				if (EQ->stream[i].handle == NULL) {
+					continue;
+				}
+				if (EQ->heap->viewKey != NULL) {
+					EQ->heap->viewKey(EQ->stream[i].key);
+					printf("\n");
+				}
+				if (EQ->heap->viewData != NULL) {
+					EQ->heap->viewData(EQ->stream[i].data);
+					printf("\n");
+				}
+			}
+			view_heap(EQ->heap);
+			break;
+		case EVENT_QUEUE_RADIX:
+			view_radix_heap(EQ->radix);
+			break;
+		case EVENT_QUEUE_CALENDAR:
+			view_calendar_queue(EQ->calendar);
+			break;
+		case EVENT_QUEUE_BTREE:
+			view_btree(EQ->btree);
+			break;
+		default:
+			view_heap(EQ->heap);
+	}
+}
+
+void * event_queue_insert(struct event_queue_t * EQ, void * key, void * data) {
+	if (EQ->keys != NULL) {//on stocke une copie de la clé
+		void * copy = pool_alloc(EQ->keys);
+		memcpy(copy, key, EQ->keySize);
+		key = copy;
+	}
+	switch (EQ->type) {
+		case EVENT_QUEUE_BST:
+		case EVENT_QUEUE_AVL:
+		case EVENT_QUEUE_RBT:
+			return tree_insert(EQ->tree, key, data);
+		case EVENT_QUEUE_STREAM:
+			if (EQ->streaming) {//le flot est encore ouvert : simple ajout en fin de tableau
+				if (EQ->stream_size == EQ->stream_capacity) {
+					int capacity = (EQ->stream_capacity == 0) ? 64 : 2 * EQ->stream_capacity;
+					struct heap_node_t * stream = realloc(EQ->stream, capacity * sizeof(struct heap_node_t));
+					if (stream == NULL) {
+						ShowMessage("src.event_queue.c:event_queue_insert : allocation impossible", 1);
+					}
+					EQ->stream = stream;
+					EQ->stream_capacity = capacity;
+				}
+				struct heap_handle_t * handle = pool_alloc(EQ->heap->handles);//l'indice est fixé à la fermeture du flot
+				handle->bucket = 1;//l'élément est dans le flot
+				EQ->stream[EQ->stream_size].key = key;
+				EQ->stream[EQ->stream_size].data = data;
+				EQ->stream[EQ->stream_size].seq = EQ->stream_size;//le tri du flot est stable : seq ne sert pas
+				EQ->stream[EQ->stream_size].handle = handle;
+				EQ->stream_size++;
+				return handle;
+			}
+			return heap_insert(EQ->heap, key, data);
+		case EVENT_QUEUE_RADIX:
+			return radix_heap_insert(EQ->radix, key, data);
+		case EVENT_QUEUE_CALENDAR:
+			calendar_queue_insert(EQ->calendar, key, data);
+			break;
+		case EVENT_QUEUE_BTREE:
+			btree_insert(EQ->btree, key, data);
+			return NULL;//les éléments se déplacent d'un nœud à l'autre : pas de référence
+		default:
+			return heap_insert(EQ->heap, key, data);
+	}
+	return key;//la clé stockée sert de référence
+}
+
+void event_queue_insert_all(struct event_queue_t * EQ, void ** keys, void ** data, int n) {
+	if ((EQ->type == EVENT_QUEUE_BST || EQ->type == EVENT_QUEUE_AVL || EQ->type == EVENT_QUEUE_RBT) && tree_is_empty(EQ->tree)
+			&& tree_keys_are_sorted(keys, n, EQ->preceed)) {//construction directe de l'arbre
+		tree_build_from_sorted(EQ->tree, keys, data, n);
+		return;
+	}
+	for (int i = 0; i < n; i++) {
+		event_queue_insert(EQ, keys[i], data[i]);
+	}
+}
+
+void * get_event_queue_min_key(struct event_queue_t * EQ) {
+	assert(!event_queue_is_empty(EQ));
+	switch (EQ->type) {
+		case EVENT_QUEUE_BST:
+		case EVENT_QUEUE_AVL:
+		case EVENT_QUEUE_RBT:
+			return get_tree_node_key(get_tree_min_node(EQ->tree));
+		case EVENT_QUEUE_STREAM:
+			close_stream(EQ);
+			return stream_is_next(EQ) ? EQ->stream[EQ->cursor].key : heap_min(EQ->heap)->key;
+		case EVENT_QUEUE_RADIX:
+			return radix_heap_min(EQ->radix)->key;
+		case EVENT_QUEUE_CALENDAR:
+			return calendar_queue_min(EQ->calendar)->key;
+		case EVENT_QUEUE_BTREE:
+			return get_btree_min_key(EQ->btree);
+		default:
+			return heap_min(EQ->heap)->key;
+	}
+}
+
+void * get_event_queue_min_data(struct event_queue_t * EQ) {
+	assert(!event_queue_is_empty(EQ));
+	switch (EQ->type) {
+		case EVENT_QUEUE_BST:
+		case EVENT_QUEUE_AVL:
+		case EVENT_QUEUE_RBT:
+			return get_tree_node_data(get_tree_min_node(EQ->tree));
+		case EVENT_QUEUE_STREAM:
+			close_stream(EQ);
+			return stream_is_next(EQ) ? EQ->stream[EQ->cursor].data : heap_min(EQ->heap)->data;
+		case EVENT_QUEUE_RADIX:
+			return radix_heap_min(EQ->radix)->data;
+		case EVENT_QUEUE_CALENDAR:
+			return calendar_queue_min(EQ->calendar)->data;
+		case EVENT_QUEUE_BTREE:
+			return get_btree_min_data(EQ->btree);
+		default:
+			return heap_min(EQ->heap)->data;
+	}
+}
+
+/**
+ * @brief
+ * Retire le prochain événement de l'ensemble non vide \p EQ et restitue sa donnée.
+ * La clé stockée est restituée par \p storedKey sans être libérée.
+ *
+ * @param[in] EQ
+ * @param[out] storedKey
+ * @return void*
+ */
+static void * pop_min_stored(struct event_queue_t * EQ, void ** storedKey) {
+	switch (EQ->type) {
+		case EVENT_QUEUE_BST:
+		case EVENT_QUEUE_AVL:
+		case EVENT_QUEUE_RBT:
+			return tree_pop_min(EQ->tree, storedKey);
+		case EVENT_QUEUE_STREAM:
+			close_stream(EQ);
+			if (stream_is_next(EQ)) {//on avance le curseur, le tableau n'est pas modifié
+				struct heap_node_t * head = &EQ->stream[EQ->cursor++];
+				pool_free(EQ->heap->handles, head->handle);
+				skip_stream_removed(EQ);
+				*storedKey = head->key;
+				return head->data;
+			}
+			return heap_remove_min(EQ->heap, storedKey);
+		case EVENT_QUEUE_RADIX:
+			return radix_heap_remove_min(EQ->radix, storedKey);
+		case EVENT_QUEUE_CALENDAR:
+			return calendar_queue_remove_min(EQ->calendar, storedKey);
+		case EVENT_QUEUE_BTREE:
+			*storedKey = NULL;//la clé disparaît avec l'élément
+			return btree_pop_min(EQ->btree);
+		default:
+			return heap_remove_min(EQ->heap, storedKey);
+	}
+}
+
+void * event_queue_pop_min(struct event_queue_t * EQ, void ** key) {
+	assert(!event_queue_is_empty(EQ));
+	void * storedKey;
+	void * data = pop_min_stored(EQ, &storedKey);
+	if (EQ->keySize > 0) {//la copie est rendue à la réserve, ou a disparu avec le nœud de l'arbre
+		assert(key == NULL);
+		if (EQ->keys != NULL) {
+			pool_free(EQ->keys, storedKey);
+		}
+	} else if (key != NULL) {
+		*key = storedKey;
+	} else if (EQ->freeKey != NULL) {
+		EQ->freeKey(storedKey);
+	}
+	return data;
+}
+
+void * event_queue_remove(struct event_queue_t * EQ, void * key) {
+	assert(!event_queue_is_empty(EQ));
+	switch (EQ->type) {
+		case EVENT_QUEUE_BST:
+		case EVENT_QUEUE_AVL:
+		case EVENT_QUEUE_RBT: {
+			void * storedKey = get_tree_node_key(tree_find_node(get_root(EQ->tree), key, EQ->tree->preceed));
+			void * data = tree_remove(EQ->tree, key);
+			if (EQ->freeKey != NULL && storedKey != key) {//tree_remove ne libère pas la clé stockée
+				EQ->freeKey(storedKey);
+			}
+			return data;
+		}
+		case EVENT_QUEUE_STREAM: {
+			close_stream(EQ);
+			void * data = heap_remove(EQ->heap, key);
+			return (data != NULL) ? data : stream_remove(EQ, key);
+		}
+		case EVENT_QUEUE_RADIX:
+			return radix_heap_remove(EQ->radix, key);
+		case EVENT_QUEUE_CALENDAR:
+			return calendar_queue_remove(EQ->calendar, key);
+		case EVENT_QUEUE_BTREE:
+			return btree_remove(EQ->btree, key);
+		default:
+			return heap_remove(EQ->heap, key);
+	}
+}
+
+void * event_queue_remove_handle(struct event_queue_t * EQ, void * handle) {
+	assert(!event_queue_is_empty(EQ));
+	void * data;
+	void * storedKey = NULL;
+	switch (EQ->type) {
+		case EVENT_QUEUE_BST:
+		case EVENT_QUEUE_AVL:
+		case EVENT_QUEUE_RBT: {
+			struct tree_node_t * node = handle;
+			storedKey = get_tree_node_key(node);
+			data = tree_remove_node(EQ->tree, node);
+			if (EQ->freeKey != NULL) {//tree_remove_node ne libère pas la clé stockée
+				EQ->freeKey(storedKey);
+			}
+			return data;
+		}
+		case EVENT_QUEUE_STREAM: {
+			close_stream(EQ);
+			struct heap_handle_t * h = handle;
+			if (h->bucket == 1) {//dans le flot : la clé est rendue quand le curseur la dépasse
+				return stream_remove_at(EQ, h->index);
+			}
+			data = heap_remove_handle(EQ->heap, h, &storedKey);
+			break;
+		}
+		case EVENT_QUEUE_RADIX:
+			data = radix_heap_remove_handle(EQ->radix, handle, &storedKey);
+			break;
+		case EVENT_QUEUE_CALENDAR:
+			data = calendar_queue_remove_handle(EQ->calendar, handle);//la clé stockée sert de référence
+			assert(data != NULL);//l'événement existe obligatoirement dans l'ensemble
+			if (EQ->keys != NULL) {//calendar_queue_remove_handle ne libère la clé qu'avec freeKey
+				pool_free(EQ->keys, handle);
+			}
+			return data;
+		case EVENT_QUEUE_BTREE:
+			ShowMessage("src.event_queue.c:event_queue_remove_handle : pas de référence dans un arbre B+", 1);
+			return NULL;
+		default:
+			data = heap_remove_handle(EQ->heap, handle, &storedKey);
+	}
+	if (EQ->keys != NULL) {//la copie de la clé est rendue à la réserve
+		pool_free(EQ->keys, storedKey);
+	} else if (EQ->freeKey != NULL) {
+		EQ->freeKey(storedKey);
+	}
+	return data;
+}
@@ -0,0 +1,256 @@
+#include "heap.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "util.h"
+#include "pool.h"
+
+/********************************************************************
+ * heap_t
+ ********************************************************************/
+
+struct heap_t * new_heap(int arity, int (*preceed)(const void *, const void *),
+						void (*viewKey)(const void *), void (*viewData)(const void *),
+						void (*freeKey)(void *), void (*freeData)(void *)) {
+	assert(arity >= 2);//un tas a au moins deux fils par élément
+	struct heap_t * H = malloc(sizeof(struct heap_t));
+	if (H == NULL) {
+		ShowMessage("src.heap.c:new_heap : allocation impossible", 1);
+	}
+	H->nodes = NULL;//le tableau est alloué à la première insertion
+	H->numelm = 0;
+	H->capacity = 0;
+	H->arity = arity;
+	H->handles = new_pool(sizeof(struct heap_handle_t));
+	H->seq = 0;
+	H->preceed = preceed;
+	H->viewKey = viewKey;
+	H->viewData = viewData;
+	H->freeKey = freeKey;
+	H->freeData = freeData;
+	return H;
+}
+
+int heap_is_empty(const struct heap_t * H) {
+	return (H->numelm == 0);
+}
+
+int get_heap_size(const struct heap_t * H) {
+	return H->numelm;
+}
+
+void delete_heap(struct heap_t * H, int deleteKey, int deleteData) {
+	assert(H != NULL);
+	for (int i = 0; i < H->numelm; i++) {//on parcourt le tableau, il n'y a pas de nœud à libérer un par un
+		if (deleteKey == 1 && H->freeKey != NULL) {
+			H->freeKey(H->nodes[i].key);
+		}
+		if (deleteData == 1 && H->freeData != NULL) {
+			H->freeData(H->nodes[i].data);
+		}
+	}
+	free(H->nodes);
+	delete_pool(H->handles);
+	free(H);
+}
+
+void view_heap(const struct heap_t * H) {
+	for (int i = 0; i < H->numelm; i++) {
+		if (H->viewKey != NULL) {
+			H->viewKey(H->nodes[i].key);
+			printf("\n");
+		}
+		if (H->viewData != NULL) {
+			H->viewData(H->nodes[i].data);
+			printf("\n");
+		}
+	}
+}
+
+/**
+ * @brief Ranger l'élément \p node à l'indice \p i du tas \p H et mettre à jour sa référence.
+ *
+ * @param[in] H
+ * @param[in] i
+ * @param[in] node
+ */
+static inline void place(struct heap_t * H, int i, struct heap_node_t node) {
+	H->nodes[i] = node;
+	node.handle->index = i;
+}
+
+/**
+ * @brief
+ * Faire remonter l'élément d'indice \p i du tas \p H jusqu'à sa place.
+ * L'élément déplacé est gardé de côté et écrit une seule fois à la fin.
+ *
+ * @param[in] H
+ * @param[in] i
+ */
+static void sift_up(struct heap_t * H, int i) {
+	struct heap_node_t moved = H->nodes[i];
+	while (i > 0) {
+		int parent = (i - 1) / H->arity;
+		if (!heap_node_preceed(H->preceed, &moved, &H->nodes[parent])) {//le parent n'est pas après : on s'arrête
+			break;
+		}
+		place(H, i, H->nodes[parent]);//on descend le parent
+		i = parent;
+	}
+	place(H, i, moved);
+}
+
+/**
+ * @brief
+ * Faire descendre l'élément d'indice \p i du tas \p H jusqu'à sa place.
+ * À chaque niveau on cherche le plus petit des (au plus arity) fils,
+ * qui sont contigus dans le tableau.
+ *
+ * @param[in] H
+ * @param[in] i
+ */
+static void sift_down(struct heap_t * H, int i) {
+	struct heap_node_t moved = H->nodes[i];
+	for (;;) {
+		int first = H->arity * i + 1;
+		if (first >= H->numelm) {//pas de fils
+			break;
+		}
+		int last = min(first + H->arity, H->numelm);
+		int best = first;
+		for (int c = first + 1; c < last; c++) {//recherche du plus petit fils
+			if (heap_node_preceed(H->preceed, &H->nodes[c], &H->nodes[best])) {
+				best = c;
+			}
+		}
+		if (!heap_node_preceed(H->preceed, &H->nodes[best], &moved)) {//aucun fils ne passe devant : on s'arrête
+			break;
+		}
+		place(H, i, H->nodes[best]);//on remonte le plus petit fils
+		i = best;
+	}
+	place(H, i, moved);
+}
+
+void heap_insert_node(struct heap_t * H, struct heap_node_t node) {
+	assert(H != NULL);
+	assert(node.key != NULL && node.handle != NULL);
+	if (H->numelm == H->capacity) {//le tableau est plein : on double sa capacité
+		int capacity = (H->capacity == 0) ? 64 : 2 * H->capacity;
+		struct heap_node_t * nodes = realloc(H->nodes, capacity * sizeof(struct heap_node_t));
+		if (nodes == NULL) {
+			ShowMessage("src.heap.c:heap_insert_node : allocation impossible", 1);
+		}
+		H->nodes = nodes;
+		H->capacity = capacity;
+	}
+	H->nodes[H->numelm] = node;
+	H->numelm++;
+	sift_up(H, H->numelm - 1);
+}
+
+struct heap_handle_t * heap_insert(struct heap_t * H, void * key, void * data) {
+	assert(H != NULL);
+	struct heap_handle_t * handle = pool_alloc(H->handles);
+	handle->bucket = 0;
+	struct heap_node_t node = { key, data, H->seq++, handle };
+	heap_insert_node(H, node);
+	return handle;
+}
+
+struct heap_node_t * heap_min(const struct heap_t * H) {
+	assert(!heap_is_empty(H));
+	return &H->nodes[0];
+}
+
+/**
+ * @brief
+ * Retirer l'élément d'indice \p i du tas \p H et restituer cet élément.
+ * Le dernier élément du tableau prend sa place puis remonte ou descend.
+ * La référence de l'élément retiré est rendue à la réserve.
+ *
+ * @param[in] H
+ * @param[in] i
+ * @return struct heap_node_t
+ */
+static struct heap_node_t remove_at(struct heap_t * H, int i) {
+	struct heap_node_t removed = H->nodes[i];
+	pool_free(H->handles, removed.handle);
+	H->numelm--;
+	if (i < H->numelm) {
+		place(H, i, H->nodes[H->numelm]);
+		if (i > 0 && heap_node_preceed(H->preceed, &H->nodes[i], &H->nodes[(i - 1) / H->arity])) {
+			sift_up(H, i);
+		} else {
+			sift_down(H, i);
+		}
+	}
+	return removed;
+}
+
+void * heap_remove_min(struct heap_t * H, void ** key) {
+	assert(!heap_is_empty(H));
+	struct heap_node_t removed = remove_at(H, 0);
+	if (key != NULL) {
+		*key = removed.key;
+	} else if (H->freeKey != NULL) {
+		H->freeKey(removed.key);
+	}
+	return removed.data;
+}
+
+/**
+ * @brief
+ * Chercher dans le sous-tas raciné à l'indice \p i l'élément de clé égale à \p key.
+ * Un sous-tas dont la racine est strictement après \p key ne peut pas la contenir.
+ * NB : fonction récursive (la profondeur est celle du tas, logarithmique),
+ * mais le nombre de sous-tas visités n'est pas borné : pour retirer un élément précis,
+ * heap_remove_handle est en O(log n).
+ *
+ * @param[in] H
+ * @param[in] i
+ * @param[in] key
+ * @return int L'indice trouvé, -1 sinon.
+ */
+static int heap_find(const struct heap_t * H, int i, const void * key) {
+	if (i >= H->numelm || H->preceed(key, H->nodes[i].key)) {
+		return -1;
+	}
+	if (!H->preceed(H->nodes[i].key, key)) {//ni avant ni après : clés égales
+		return i;
+	}
+	for (int c = H->arity * i + 1; c <= H->arity * i + H->arity; c++) {
+		int found = heap_find(H, c, key);
+		if (found != -1) {
+			return found;
+		}
+	}
+	return -1;
+}
+
+void * heap_remove(struct heap_t * H, void * key) {
+	assert(H != NULL);
+	int i = heap_find(H, 0, key);
+	if (i == -1) {
+		return NULL;
+	}
+	struct heap_node_t removed = remove_at(H, i);
+	if (H->freeKey != NULL) {
+		H->freeKey(removed.key);
+	}
+	return removed.data;
+}
+
+void * heap_remove_handle(struct heap_t * H, struct heap_handle_t * handle, void ** key) {
+	assert(H != NULL && handle != NULL);
+	assert(handle->index < H->numelm && H->nodes[handle->index].handle == handle);
+	struct heap_node_t removed = remove_at(H, handle->index);
+	if (key != NULL) {
+		*key = removed.key;
+	} else if (H->freeKey != NULL) {
+		H->freeKey(removed.key);
+	}
+	return removed.data;
+}
@@ -4,8 +4,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <limits.h>
 
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
 #include "util.h"
 #include "list.h"
 
@@ -46,44 +51,257 @@ void delete_task(void * task) {
  * Instance
  ********************************************************************/
 
+/**
+ * @brief Lire un entier décimal à partir de \p p (sans dépasser \p end) dans \p value,
+ * et restituer la position qui suit son dernier chiffre (\p p s'il n'y a pas de chiffre).
+ * Comme strtoul avec ERANGE, une valeur supérieure à ULONG_MAX est une erreur.
+ * 
+ * @param[in] p 
+ * @param[in] end 
+ * @param[out] value 
+ * @return const char* 
+ */
+static const char * scan_ulong(const char * p, const char * end, unsigned long * value) {
+	unsigned long v = 0;
+	while (p < end && *p >= '0' && *p <= '9') {
+		unsigned long digit = (unsigned long) (*p - '0');
+		if (v > (ULONG_MAX - digit) / 10) {//v * 10 + digit dépasserait ULONG_MAX
+			ShowMessage("src.instance.c:read_instance : valeur hors limites", 1);
+		}
+		v = v * 10 + digit;
+		p++;
+	}
+	*value = v;
+	return p;
+}
+
+static const char * skip_blanks(const char * p, const char * end) {
+	while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+		p++;
+	}
+	return p;
+}
+
+/**
+ * @brief Analyser les lignes "id processing_time release_time" comprises entre \p begin et \p end
+ * (les lignes vides sont ignorées) et les écrire dans le tableau \p tasks, qui a assez de cases
+ * pour toutes les lignes. L'identifiant de chaque tâche pointe dans le texte analysé et n'est pas
+ * terminé par '\0' : sa longueur est écrite dans \p id_lengths.
+ * 
+ * @param[in] begin 
+ * @param[in] end 
+ * @param[out] tasks 
+ * @param[out] id_lengths 
+ * @return size_t le nombre de tâches lues
+ */
+static size_t scan_tasks(const char * begin, const char * end, struct task_t * tasks, size_t * id_lengths) {
+	size_t n = 0;
+	const char * p = begin;
+	while (p < end) {
+		p = skip_blanks(p, end);
+		if (p == end || *p == '\n') {//ligne vide
+			p++;
+			continue;
+		}
+		const char * id = p;
+		while (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') {
+			p++;
+		}
+		tasks[n].id = (char *) id;
+		id_lengths[n] = p - id;
+		const char * q = skip_blanks(p, end);
+		p = scan_ulong(q, end, &tasks[n].processing_time);
+		if (p == q) {
+			ShowMessage("src.instance.c:read_instance : erreur processing time", 1);
+		}
+		q = skip_blanks(p, end);
+		p = scan_ulong(q, end, &tasks[n].release_time);
+		if (p == q) {
+			ShowMessage("src.instance.c:read_instance : erreur release time", 1);
+		}
+		p = skip_blanks(p, end);
+		if (p < end && *p != '\n') {
+			ShowMessage("src.instance.c:read_instance : ligne invalide", 1);
+		}
+		p++;
+		n++;
+	}
+	return n;
+}
+
+/**
+ * @brief
+ * Un morceau du fichier analysé par un fil d'exécution de read_instance_parallel :
+ * (+) le texte du morceau, de begin à end (il commence et finit en début de ligne),
+ * (+) les tâches lues (tasks, num_tasks), dont les identifiants pointent dans le texte,
+ *     et la longueur de chaque identifiant (id_lengths),
+ * (+) la taille (id_bytes) de ses identifiants terminés par '\0', et
+ * (+) les positions où recopier ses tâches (out_tasks) et ses identifiants (out_ids)
+ *     dans les blocs de l'instance.
+ */
+struct instance_chunk_t {
+	const char * begin;
+	const char * end;
+	struct task_t * tasks;
+	size_t * id_lengths;
+	size_t num_tasks;
+	size_t id_bytes;
+	struct task_t * out_tasks;
+	char * out_ids;
+};
+
+#define INSTANCE_MIN_CHUNK_SIZE (1 << 20)
+
+/**
+ * @brief Première phase : analyser les lignes du morceau \p arg dans un tableau local.
+ */
+static void * parse_instance_chunk(void * arg) {
+	struct instance_chunk_t * C = arg;
+	size_t lines = 1;//une tâche par ligne au plus
+	for (const char * p = C->begin; p < C->end && (p = memchr(p, '\n', C->end - p)) != NULL; p++) {
+		lines++;
+	}
+	C->tasks = (struct task_t *) malloc(lines * sizeof(struct task_t));
+	C->id_lengths = (size_t *) malloc(lines * sizeof(size_t));
+	if (C->tasks == NULL || C->id_lengths == NULL) {
+		ShowMessage("src.instance.c:read_instance : allocation impossible",1);
+	}
+	C->num_tasks = scan_tasks(C->begin, C->end, C->tasks, C->id_lengths);
+	C->id_bytes = 0;
+	for (size_t i = 0; i < C->num_tasks; i++) {
+		C->id_bytes += C->id_lengths[i] + 1;
+	}
+	return NULL;
+}
+
+/**
+ * @brief Seconde phase : recopier les tâches et les identifiants du morceau \p arg à leur place
+ * dans les blocs de l'instance, puis libérer son tableau local.
+ */
+static void * copy_instance_chunk(void * arg) {
+	struct instance_chunk_t * C = arg;
+	char * next = C->out_ids;
+	for (size_t i = 0; i < C->num_tasks; i++) {
+		memcpy(next, C->tasks[i].id, C->id_lengths[i]);
+		next[C->id_lengths[i]] = '\0';
+		C->out_tasks[i] = C->tasks[i];
+		C->out_tasks[i].id = next;
+		next += C->id_lengths[i] + 1;
+	}
+	free(C->tasks);
+	free(C->id_lengths);
+	return NULL;
+}
+
+/**
+ * @brief Appliquer \p phase aux \p num_chunks morceaux \p chunks, un fil d'exécution par morceau
+ * (le fil appelant traite le premier).
+ */
+static void run_instance_chunks(struct instance_chunk_t * chunks, int num_chunks, void * (*phase)(void *)) {
+	pthread_t * threads = (pthread_t *) malloc(num_chunks * sizeof(pthread_t));
+	if (threads == NULL) {
+		ShowMessage("src.instance.c:read_instance : allocation impossible",1);
+	}
+	int * started = (int *) calloc(num_chunks, sizeof(int));
+	if (started == NULL) {
+		ShowMessage("src.instance.c:read_instance : allocation impossible",1);
+	}
+	for (int k = 1; k < num_chunks; k++) {
+		started[k] = pthread_create(&threads[k], NULL, phase, &chunks[k]) == 0;
+	}
+	phase(&chunks[0]);
+	for (int k = 1; k < num_chunks; k++) {
+		if (started[k]) {
+			pthread_join(threads[k], NULL);
+		} else {//pas de fil disponible : le morceau est traité ici
+			phase(&chunks[k]);
+		}
+	}
+	free(started);
+	free(threads);
+}
+
 Instance read_instance(const char * filename) {
+	return read_instance_parallel(filename, 0);
+}
+
+Instance read_instance_parallel(const char * filename, int num_threads) {
 	assert(filename);//vérifie que le nom du fichier n'est pas null
-	//Ouvre le fichier
-	FILE *file = fopen(filename, "r");//ouvre le fichier en lecture
-	if (file) {//si l'ouverture a échoué
-		ShowMessage("impossible d'ouvrir le fichier",1);
-	}
-	// Initialise une nouvelle instance 
-	Instance I = new_list(view_task, delete_task);
-	// Lit le fichier ligne par ligne
-	char * line = NULL;// chaine de caractère pour stocker chaque ligne du fichier
-	size_t len = 0;// taille initiale de la chaine de caractère(0 pour que getline alloue la mémoire)
-	ssize_t read;// nombre de caractère lu par la ligne courante
-	char *token;// chaine de caractère pour stocker chaque partie de la ligne (id, processing time, release time)
-	char delim=' ';//Délimiteur
-	while ((read = getline(&line, &len, file)) != -1) {
-		//découpe la ligne en 3 parties,
-		token=strtok(line,&delim);//id
-		char* endptr; // pointeur pour vérifier si la conversion a réussi
-		char *id=token;//convertit la chaine de caractère en char *
-		token=strtok(NULL,&delim);//processing time
-		unsigned long processing_time=strtoul(token,&endptr,10);//convertit la chaine de caractère en unsigned long
-		if (endptr == token || *endptr != '\0') { // la conversion a échoué
-			ShowMessage("erreur processing time ",1);
+	//Projette le fichier en mémoire
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0) {//si l'ouverture a échoué
+		ShowMessage("src.instance.c:read_instance : impossible d'ouvrir le fichier",1);
+	}
+	struct stat st;
+	if (fstat(fd, &st) < 0) {
+		ShowMessage("src.instance.c:read_instance : impossible de lire la taille du fichier",1);
+	}
+	size_t size = st.st_size;
+	const char * text = NULL;
+	if (size > 0) {
+		text = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (text == MAP_FAILED) {
+			ShowMessage("src.instance.c:read_instance : projection impossible",1);
 		}
-		token=strtok(NULL,&delim);//release time
-		unsigned long release_time=strtoul(token,&endptr,10);//convertit la chaine de caractère en unsigned long
-		if (endptr == token || *endptr != '\0') { // la conversion a échoué
-			ShowMessage("erreur releasedtime",1);
+		madvise((void *) text, size, MADV_SEQUENTIAL);
+	}
+	close(fd);
+
+	//Découpe le fichier en morceaux alignés sur les fins de ligne
+	if (num_threads <= 0) {
+		num_threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+		num_threads = min((size_t) num_threads, size / INSTANCE_MIN_CHUNK_SIZE);
+	}
+	int num_chunks = (int) max((size_t) 1, min((size_t) num_threads, size));
+	struct instance_chunk_t * chunks = (struct instance_chunk_t *) calloc(num_chunks, sizeof(struct instance_chunk_t));
+	if (chunks == NULL) {
+		ShowMessage("src.instance.c:read_instance : allocation impossible",1);
+	}
+	const char * begin = text;
+	for (int k = 0; k < num_chunks; k++) {
+		const char * end = text + size;
+		if (k < num_chunks - 1) {
+			end = max(begin, text + (size / num_chunks) * (k + 1));
+			const char * newline = end < text + size ? memchr(end, '\n', text + size - end) : NULL;
+			end = newline != NULL ? newline + 1 : text + size;
 		}
-		//crée une nouvelle tâche avec ces 3 parties et l'ajoute à l'instance
-		struct task_t * task = new_task(id, processing_time, release_time);//crée une nouvelle tâche
-		list_insert_after(I,task, get_list_tail(I));//ajoute la tâche à l'instance
-	}
-	//Libère la mémoire
-	free(line);//libère la mémoire allouée par getline
-	free(token);//libère la mémoire allouée par strtok
-	fclose(file);//ferme le fichier
+		chunks[k].begin = begin;
+		chunks[k].end = end;
+		begin = end;
+	}
+	run_instance_chunks(chunks, num_chunks, parse_instance_chunk);
+
+	//Place les tâches puis les identifiants de chaque morceau dans un seul bloc, dans l'ordre du fichier
+	size_t n = 0, arena_size = 0;
+	for (int k = 0; k < num_chunks; k++) {
+		n += chunks[k].num_tasks;
+		arena_size += chunks[k].id_bytes;
+	}
+	if (n > INT_MAX) {//la liste compte ses éléments avec un int
+		ShowMessage("src.instance.c:read_instance : trop de tâches",1);
+	}
+	struct task_t * tasks = (struct task_t *) malloc(n * sizeof(struct task_t) + arena_size + 1);
+	if (tasks == NULL) {
+		ShowMessage("src.instance.c:read_instance : allocation impossible",1);
+	}
+	char * arena = (char *) (tasks + n);
+	struct task_t * out_tasks = tasks;
+	char * out_ids = arena;
+	for (int k = 0; k < num_chunks; k++) {
+		chunks[k].out_tasks = out_tasks;
+		chunks[k].out_ids = out_ids;
+		out_tasks += chunks[k].num_tasks;
+		out_ids += chunks[k].id_bytes;
+	}
+	run_instance_chunks(chunks, num_chunks, copy_instance_chunk);
+	free(chunks);
+	if (size > 0) {
+		munmap((void *) text, size);
+	}
+
+	// Initialise une nouvelle instance avec les tâches dans l'ordre du fichier :
+	// ses nœuds forment un seul tableau et elle est propriétaire du bloc
+	Instance I = new_list_from_block(tasks, sizeof(struct task_t), (int) n, view_task);
 	return I;//retourne l'instance
 }
 
@@ -94,14 +312,5 @@ void view_instance(Instance I) {
 
 void delete_instance(Instance I, int deleteData) {
 	assert(I);//vérifie que l'instance n'est pas null
-	struct list_node_t * node = I->head;//pointeur sur le premier élément de la liste
-	while (node) {//parcours la liste
-		struct list_node_t * next = node->successor;//pointeur sur le prochain élément de la liste
-		if (deleteData){//si deleteData est vrai
-			I->freeData(node->data);//supprime les données de la tâche
-		}
-		free(node);//libère la mémoire allouée pour le noeud
-		node = next;//passe au noeud suivant
-	}
-	free(I);//libère la mémoire allouée pour l'instance
+	delete_list(I, deleteData);//libère aussi le bloc des tâches d'une instance lue par read_instance
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <stdint.h>
 
 #include "util.h"
 #include "tree.h"
@@ -27,6 +28,21 @@ static struct list_node_t *new_list_node(void *data)
 	return newListNode;
 }
 
+/**
+ * @brief
+ * Libère le nœud \p node retiré de la liste \p L, sauf s'il appartient au tableau
+ * des nœuds de \p L (voir new_list_from_block), libéré avec la liste.
+ *
+ * @param[in] L
+ * @param[in] node
+ */
+static void free_list_node(struct list_t *L, struct list_node_t *node)
+{
+	if ((uintptr_t) node - (uintptr_t) L->node_block < (uintptr_t) L->node_block_size * sizeof(struct list_node_t))
+		return;
+	free(node);
+}
+
 void *get_list_node_data(const struct list_node_t *node)
 {
 	return node->data;
@@ -69,9 +85,35 @@ struct list_t *new_list(void (*viewData)(const void *), void (*freeData)(void *)
 	newList->numelm = 0;
 	newList->viewData = viewData;
 	newList->freeData = freeData;
+	newList->node_block = NULL;
+	newList->node_block_size = 0;
+	newList->data_block = NULL;
 	return newList;
 }
 
+struct list_t *new_list_from_block(void *data_block, size_t size, int n, void (*viewData)(const void *))
+{
+	assert(n >= 0);
+	struct list_t *L = new_list(viewData, NULL);
+	L->node_block = malloc(max(n, 1) * sizeof(struct list_node_t));
+	if (L->node_block == NULL)
+	{
+		ShowMessage("src.list.c:new_list_from_block : allocation impossible", 1);
+	}
+	L->node_block_size = n;
+	L->data_block = data_block;
+	for (int i = 0; i < n; i++)//on chaîne les nœuds du tableau dans l'ordre des données
+	{
+		L->node_block[i].data = (char *) data_block + i * size;
+		L->node_block[i].predecessor = (i > 0) ? &L->node_block[i - 1] : NULL;
+		L->node_block[i].successor = (i < n - 1) ? &L->node_block[i + 1] : NULL;
+	}
+	L->head = (n > 0) ? &L->node_block[0] : NULL;
+	L->tail = (n > 0) ? &L->node_block[n - 1] : NULL;
+	L->numelm = n;
+	return L;
+}
+
 int list_is_empty(struct list_t *L)
 {
 	return (L->numelm == 0);
@@ -113,50 +155,30 @@ void set_list_size(struct list_t *L, int newSize)
 
 void set_head(struct list_t *L, struct list_node_t *newHead)
 {
-	if (list_is_empty(L))//illogique de donner une liste vide mais on sait jamais 
-	{
-		// Si la liste est vide, on ne peut pas modifier la tête de la liste
-		// car la tête est NULL, et on ne peut pas modifier un pointeur NULL
-		// On affiche donc un message d'erreur et on quitte la fonction
-		ShowMessage("src.list.c:set_head : La liste est vide !", 1);
-	}
-	else
-	{
-		L->head = newHead;
-	}
+	// La tête d'une liste vide est modifiée lors de la première insertion
+	L->head = newHead;
 }
 
 void set_tail(struct list_t *L, struct list_node_t *newTail)
 {
-	if (list_is_empty(L))
-	{
-		// Meme raisonnement que pour set_head
-		ShowMessage("src.list.c:set_tail : La liste est vide !",1);
-	}
-		L->tail = newTail;
+	// Meme raisonnement que pour set_head
+	L->tail = newTail;
 }
 
 void delete_list(struct list_t *L, int deleteData)
 {
 	struct list_node_t* current = L->head;
 	struct list_node_t* sucessor_node;//permettra de prendre les noeuds suivants de current et de les supprimer les uns après les autres 
-	if (list_is_empty(L))
-	{
-		ShowMessage("src.list.c:delete_list : La liste est déjà vide !", 1);
-	}
-	else
-		{
-			while(current != NULL){//permet de parcourir les noeuds tant que la liste n'est pas vide
-				sucessor_node = get_successor(current); //on se sert de ce noeud pour ne pas perdre le successeur de la tête de liste, on libère donc la liste de la tête vers la queue de la liste 
-				if ((deleteData == 1) && (L->freeData != NULL)){//comme descrit dans la définition de la fonction
-					L->freeData(current->data);//appelle de la fonction freedata pour libérer la data du noeud courrent
-				}
-				free(current);// libère le noeud courant
-				current = sucessor_node; //current étant libérer on le remplace par son successeur stocké au préalable
-			}
-			 
-
+	while(current != NULL){//permet de parcourir les noeuds tant que la liste n'est pas vide (une liste vide n'a rien à parcourir)
+		sucessor_node = get_successor(current); //on se sert de ce noeud pour ne pas perdre le successeur de la tête de liste, on libère donc la liste de la tête vers la queue de la liste 
+		if ((deleteData == 1) && (L->freeData != NULL)){//comme descrit dans la définition de la fonction
+			L->freeData(current->data);//appelle de la fonction freedata pour libérer la data du noeud courrent
+		}
+		free_list_node(L, current);// libère le noeud courant
+		current = sucessor_node; //current étant libérer on le remplace par son successeur stocké au préalable
 	}
+	free(L->node_block);//le tableau des nœuds et le bloc des données d'une liste construite par new_list_from_block
+	free(L->data_block);
 	free(L);//quand tous les noeuds de la liste sont libérer, on libère la liste
 }
 
@@ -216,7 +238,7 @@ void *list_remove_first(struct list_t *L)
 {
 	assert(get_list_head(L));//on vérifie que la liste n'est pas vide 
 	struct list_node_t *temp = get_list_head(L); //on crée un noeud temporaire pour recevoir la tête de liste
-	if(get_successor(L->head->successor) == NULL)//si le successeur de la tête est null alors la liste n'a qu'un élément et on ne pourra modifier la tête de L avec son successeur étant donné qu'il n'y en a pas
+	if(get_successor(L->head) == NULL)//si le successeur de la tête est null alors la liste n'a qu'un élément et on ne pourra modifier la tête de L avec son successeur étant donné qu'il n'y en a pas
 	{
 		L->head = NULL;//si on supprime le seul élément de la liste alors la queue et la tête pointe sur null
 		L->tail = NULL;
@@ -226,7 +248,7 @@ void *list_remove_first(struct list_t *L)
 	}
 	decrease_list_size(L);//étant donnée que l'on retire un élément il faut décrémenté numelm
 	void *data = get_list_node_data(temp);//on stocke la data dans data pour ne pas perdre la donnée
-	free(temp);//on libère l'ancienne tête de L en ayant au préalable supprimé les liens où il y avait une relation avec la Liste ou son successeur
+	free_list_node(L, temp);//on libère l'ancienne tête de L en ayant au préalable supprimé les liens où il y avait une relation avec la Liste ou son successeur
 	return data;
 }
 
@@ -234,17 +256,17 @@ void *list_remove_last(struct list_t *L)// quasi similaire à remove_first
 {
 	assert(get_list_head(L));//on vérifie que la liste n'est pas vide 
 	struct list_node_t *temp = get_list_tail(L); //on crée un noeud temporaire pour recevoir la queue de la liste
-	if(get_successor(L->head->successor) == NULL)//si le successeur de la tête est null alors la liste n'a qu'un élément et on ne pourra pas modifier la queue de L avec son prédeccesseur étant donné qu'il n'y en a pas
+	if(get_successor(L->head) == NULL)//si le successeur de la tête est null alors la liste n'a qu'un élément et on ne pourra pas modifier la queue de L avec son prédeccesseur étant donné qu'il n'y en a pas
 	{
 		L->head = NULL;//si on supprime le seul élément de la liste alors la queue et la tête pointe sur null
 		L->tail = NULL;
 	}else{ //sinon la liste à plus d'1 élément
 		set_tail(L, get_predecessor(temp));//la queue de la liste recoit le predeccesseur de sa queue actuel comme nouvelle queue 
-		set_successor(temp, NULL);//le successeur de la nouvelle queue ne doit donc plus pointé sur le noeud que l'on veux supprimé et donc pointé sur null
+		set_successor(get_list_tail(L), NULL);//le successeur de la nouvelle queue ne doit donc plus pointé sur le noeud que l'on veux supprimé et donc pointé sur null
 	}
 	decrease_list_size(L);//étant donnée que l'on retire un élément il faut décrémenté numelm
 	void *data = get_list_node_data(temp);//on stocke la data dans data pour ne pas perdre la donnée
-	free(temp);//on libère l'ancienne tête de L en ayant au préalable supprimé les liens où il y avait une relation avec la Liste ou son successeur
+	free_list_node(L, temp);//on libère l'ancienne tête de L en ayant au préalable supprimé les liens où il y avait une relation avec la Liste ou son successeur
 	return data;
 }
 
@@ -265,6 +287,6 @@ void *list_remove_node(struct list_t *L, struct list_node_t *node)
 		node->successor->predecessor = node->predecessor;//le pointeur predecceur du noeud suivant node pointe désormais sur le predeccesseur du noeud node
 	}
 	decrease_list_size(L);//on supprime le noeud node de la liste donc il faut decrementer la liste
-	free(node);//on libère le noeuds que l'on souhaite supprimé 
+	free_list_node(L, node);//on libère le noeuds que l'on souhaite supprimé 
 	return data;
 }
\ No newline at end of file
@@ -8,19 +8,30 @@
 
 void display_help() {
 	ShowMessage("", 0);
-	ShowMessage("make run in=infilename out=outfilename m=machines pre=preemption bal=balanced\n", 0);
+	ShowMessage("make run in=infilename out=outfilename m=machines pre=preemption bal=balanced [stream=1|2]\n", 0);
 	ShowMessage("preemption:", 0);
 	ShowMessage("\t0 - without preemption", 0);
 	ShowMessage("\t1 - with preemption", 0);
 	ShowMessage("", 0);
 	ShowMessage("balanced:", 0);
 	ShowMessage("\t0 - use a binary search tree", 0);
-	ShowMessage("\t1 - use a balanced binary search tree", 0);
+	ShowMessage("\t1 - use a balanced binary search tree (AVL)", 0);
+	ShowMessage("\t2 - use a d-ary heap for the events (balanced tree for the queue)", 0);
+	ShowMessage("\t3 - use a sorted release stream and a small heap for the events (balanced tree for the queue)", 0);
+	ShowMessage("\t4 - use a radix heap for the events (balanced tree for the queue)", 0);
+	ShowMessage("\t5 - use a calendar queue for the events (balanced tree for the queue)", 0);
+	ShowMessage("\t6 - use a red-black tree", 0);
+	ShowMessage("\t7 - use a B+ tree for the queue (balanced tree for the events)", 0);
+	ShowMessage("\t8 - use balanced binary search trees specialized for their keys", 0);
+	ShowMessage("", 0);
+	ShowMessage("stream:", 0);
+	ShowMessage("\t1 - write each finished segment as a line \"machine id begin end\" while scheduling (bounded memory, usable with a pipe)", 0);
+	ShowMessage("\t2 - same file as without stream, buffered by machine and written at the end (schedule memory in O(machines))", 0);
 	ShowMessage("", 1);
 }
 
 int main(int argc, char *argv[]) {
-	if (argc != 6)
+	if (argc != 6 && argc != 7)
 		display_help();
 
 	char* infilename = argv[1];
@@ -28,8 +39,25 @@ int main(int argc, char *argv[]) {
 	int m = atoi(argv[3]);
 	int preemption = atoi(argv[4]);
 	int balanced = atoi(argv[5]);
+	int stream = argc == 7 ? atoi(argv[6]) : 0;
 
 	Instance I = read_instance(infilename);
+	if (stream) {//les segments sont confiés à l'écrivain au fil de la simulation
+		struct schedule_t * S;
+		if (stream == 2) {//même fichier que save_schedule, écrit à la fin
+			struct saved_schedule_writer_t * W = new_saved_schedule_writer(outfilename, m);
+			S = create_schedule_streaming(I, m, preemption, balanced, write_saved_schedule_segment, W);
+			delete_saved_schedule_writer(W);
+		} else {//lignes "machine id begin end", écrites au fil de la simulation
+			struct output_buffer_t * W = new_schedule_writer(outfilename);
+			S = create_schedule_streaming(I, m, preemption, balanced, write_schedule_segment, W);
+			delete_schedule_writer(W);
+		}
+		printf("The makespan of the constructed schedule is %lu\n\n", get_makespan(S));
+		delete_schedule(S);
+		delete_instance(I, 1);
+		return EXIT_SUCCESS;
+	}
 	struct schedule_t * S = create_schedule(I, m, preemption, balanced);
 	printf("The makespan of the constructed schedule is %lu\n\n", get_makespan(S));
 	view_schedule(S);
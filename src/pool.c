@@ -0,0 +1,70 @@
+#include "pool.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "util.h"
+
+struct pool_t * new_pool(size_t size) {
+	struct pool_t * P = malloc(sizeof(struct pool_t));
+	if (P == NULL) {
+		ShowMessage("src.pool.c:new_pool : allocation impossible", 1);
+	}
+	size = max(size, sizeof(void *));//un emplacement libre contient l'adresse du suivant
+	P->size = (size + sizeof(max_align_t) - 1) / sizeof(max_align_t) * sizeof(max_align_t);
+	P->chunks = NULL;
+	P->freelist = NULL;
+	P->next = NULL;
+	P->end = NULL;
+	P->numelm = 0;
+	return P;
+}
+
+int get_pool_size(const struct pool_t * P) {
+	return P->numelm;
+}
+
+void delete_pool(struct pool_t * P) {
+	assert(P != NULL);
+	struct pool_chunk_t * chunk = P->chunks;
+	while (chunk != NULL) {
+		struct pool_chunk_t * next = chunk->next;
+		free(chunk);
+		chunk = next;
+	}
+	free(P);
+}
+
+void * pool_alloc(struct pool_t * P) {
+	assert(P != NULL);
+	void * ptr;
+	if (P->freelist != NULL) {//on recycle le dernier emplacement libéré
+		ptr = P->freelist;
+		P->freelist = *(void **) ptr;
+	} else {
+		if (P->next == P->end) {//le dernier bloc est épuisé
+			struct pool_chunk_t * chunk = malloc(sizeof(struct pool_chunk_t) + POOL_CHUNK_SIZE * P->size);
+			if (chunk == NULL) {
+				ShowMessage("src.pool.c:pool_alloc : allocation impossible", 1);
+			}
+			chunk->next = P->chunks;
+			P->chunks = chunk;
+			P->next = (char *) chunk->slots;
+			P->end = P->next + POOL_CHUNK_SIZE * P->size;
+		}
+		ptr = P->next;
+		P->next += P->size;
+	}
+	P->numelm++;
+	return ptr;
+}
+
+void pool_free(struct pool_t * P, void * ptr) {
+	assert(P != NULL);
+	if (ptr == NULL) {
+		return;
+	}
+	*(void **) ptr = P->freelist;
+	P->freelist = ptr;
+	P->numelm--;
+}
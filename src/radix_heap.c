@@ -0,0 +1,255 @@
+#include "radix_heap.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "util.h"
+#include "heap.h"
+#include "pool.h"
+
+/********************************************************************
+ * radix_bucket_t
+ ********************************************************************/
+
+/**
+ * @brief
+ * Ajouter l'élément \p node à la fin du seau d'indice \p i du tas radix \p R
+ * (le tableau est doublé si nécessaire) et mettre à jour sa référence.
+ *
+ * @param[in] R
+ * @param[in] i
+ * @param[in] node
+ */
+static void bucket_push(struct radix_heap_t * R, int i, struct heap_node_t node) {
+	struct radix_bucket_t * B = &R->buckets[i];
+	if (B->numelm == B->capacity) {
+		int capacity = (B->capacity == 0) ? 16 : 2 * B->capacity;
+		struct heap_node_t * nodes = realloc(B->nodes, capacity * sizeof(struct heap_node_t));
+		if (nodes == NULL) {
+			ShowMessage("src.radix_heap.c:bucket_push : allocation impossible", 1);
+		}
+		B->nodes = nodes;
+		B->capacity = capacity;
+	}
+	node.handle->bucket = i;
+	node.handle->index = B->numelm;
+	B->nodes[B->numelm++] = node;
+}
+
+/**
+ * @brief
+ * Retirer et restituer l'élément d'indice \p j du seau \p B :
+ * le dernier élément du seau prend sa place (l'ordre dans un seau n'a pas d'importance).
+ *
+ * @param[in] B
+ * @param[in] j
+ * @return struct heap_node_t
+ */
+static struct heap_node_t bucket_remove_at(struct radix_bucket_t * B, int j) {
+	struct heap_node_t removed = B->nodes[j];
+	B->nodes[j] = B->nodes[--B->numelm];
+	B->nodes[j].handle->index = j;
+	return removed;
+}
+
+/********************************************************************
+ * radix_heap_t
+ ********************************************************************/
+
+/**
+ * @brief
+ * Restitue l'indice du seau d'une clé de date \p t lorsque la dernière date extraite est \p last :
+ * 0 si t=last, sinon 1 + la position du bit de poids fort de (t XOR last).
+ *
+ * @param[in] last
+ * @param[in] t
+ * @return int
+ */
+static inline int bucket_index(unsigned long last, unsigned long t) {
+	return (t == last) ? 0 : (int) (8 * sizeof(unsigned long)) - __builtin_clzl(t ^ last);
+}
+
+struct radix_heap_t * new_radix_heap(unsigned long (*time)(const void *),
+						int (*preceed)(const void *, const void *),
+						void (*viewKey)(const void *), void (*viewData)(const void *),
+						void (*freeKey)(void *), void (*freeData)(void *)) {
+	assert(time != NULL);
+	struct radix_heap_t * R = malloc(sizeof(struct radix_heap_t));
+	if (R == NULL) {
+		ShowMessage("src.radix_heap.c:new_radix_heap : allocation impossible", 1);
+	}
+	R->last = 0;
+	for (unsigned i = 0; i < RADIX_HEAP_BUCKETS; i++) {
+		R->buckets[i].nodes = NULL;
+		R->buckets[i].numelm = 0;
+		R->buckets[i].capacity = 0;
+	}
+	R->ties = new_heap(HEAP_DEFAULT_ARITY, preceed, viewKey, viewData, freeKey, freeData);
+	R->numelm = 0;
+	R->seq = 0;
+	R->time = time;
+	R->freeKey = freeKey;
+	R->freeData = freeData;
+	return R;
+}
+
+int radix_heap_is_empty(const struct radix_heap_t * R) {
+	return (R->numelm == 0);
+}
+
+int get_radix_heap_size(const struct radix_heap_t * R) {
+	return R->numelm;
+}
+
+void delete_radix_heap(struct radix_heap_t * R, int deleteKey, int deleteData) {
+	assert(R != NULL);
+	for (unsigned i = 1; i < RADIX_HEAP_BUCKETS; i++) {
+		struct radix_bucket_t * B = &R->buckets[i];
+		for (int j = 0; j < B->numelm; j++) {
+			if (deleteKey == 1 && R->freeKey != NULL) {
+				R->freeKey(B->nodes[j].key);
+			}
+			if (deleteData == 1 && R->freeData != NULL) {
+				R->freeData(B->nodes[j].data);
+			}
+		}
+		free(B->nodes);
+	}
+	delete_heap(R->ties, deleteKey, deleteData);
+	free(R);
+}
+
+void view_radix_heap(const struct radix_heap_t * R) {
+	view_heap(R->ties);
+	for (unsigned i = 1; i < RADIX_HEAP_BUCKETS; i++) {
+		for (int j = 0; j < R->buckets[i].numelm; j++) {
+			if (R->ties->viewKey != NULL) {
+				R->ties->viewKey(R->buckets[i].nodes[j].key);
+				printf("\n");
+			}
+			if (R->ties->viewData != NULL) {
+				R->ties->viewData(R->buckets[i].nodes[j].data);
+				printf("\n");
+			}
+		}
+	}
+}
+
+struct heap_handle_t * radix_heap_insert(struct radix_heap_t * R, void * key, void * data) {
+	assert(R != NULL);
+	unsigned long t = R->time(key);
+	assert(t >= R->last);//la file est monotone
+	int i = bucket_index(R->last, t);
+	struct heap_handle_t * handle = pool_alloc(R->ties->handles);
+	struct heap_node_t node = { key, data, R->seq++, handle };//le numéro suit l'élément jusqu'au tas ties
+	if (i == 0) {
+		handle->bucket = 0;
+		heap_insert_node(R->ties, node);
+	} else {
+		bucket_push(R, i, node);
+	}
+	R->numelm++;
+	return handle;
+}
+
+/**
+ * @brief
+ * S'assurer que le seau 0 (le tas ties) n'est pas vide si le tas radix \p R n'est pas vide :
+ * le premier seau non vide est vidé, last devient la plus petite date de ce seau
+ * et ses éléments sont redistribués dans des seaux d'indice strictement plus petit.
+ * Chaque élément ne peut que descendre de seau, d'où le coût amorti constant.
+ *
+ * @param[in] R
+ */
+static void refill_ties(struct radix_heap_t * R) {
+	if (!heap_is_empty(R->ties) || R->numelm == 0) {
+		return;
+	}
+	unsigned i = 1;
+	while (R->buckets[i].numelm == 0) {
+		i++;
+	}
+	struct radix_bucket_t * B = &R->buckets[i];
+	unsigned long last = R->time(B->nodes[0].key);
+	for (int j = 1; j < B->numelm; j++) {
+		unsigned long t = R->time(B->nodes[j].key);
+		if (t < last) {
+			last = t;
+		}
+	}
+	R->last = last;
+	int n = B->numelm;
+	B->numelm = 0;//le seau i ne reçoit aucun de ses éléments
+	for (int j = 0; j < n; j++) {
+		int k = bucket_index(last, R->time(B->nodes[j].key));
+		assert(k < (int) i);
+		if (k == 0) {
+			B->nodes[j].handle->bucket = 0;
+			heap_insert_node(R->ties, B->nodes[j]);
+		} else {
+			bucket_push(R, k, B->nodes[j]);
+		}
+	}
+}
+
+struct heap_node_t * radix_heap_min(struct radix_heap_t * R) {
+	assert(!radix_heap_is_empty(R));
+	refill_ties(R);
+	return heap_min(R->ties);
+}
+
+void * radix_heap_remove_min(struct radix_heap_t * R, void ** key) {
+	assert(!radix_heap_is_empty(R));
+	refill_ties(R);
+	R->numelm--;
+	return heap_remove_min(R->ties, key);
+}
+
+void * radix_heap_remove(struct radix_heap_t * R, void * key) {
+	assert(R != NULL);
+	unsigned long t = R->time(key);
+	if (t < R->last) {//date déjà dépassée : la clé ne peut pas être dans le tas
+		return NULL;
+	}
+	int i = bucket_index(R->last, t);
+	void * data = NULL;
+	if (i == 0) {
+		data = heap_remove(R->ties, key);
+	} else {
+		struct radix_bucket_t * B = &R->buckets[i];
+		for (int j = 0; j < B->numelm; j++) {
+			void * k = B->nodes[j].key;
+			if (!R->ties->preceed(k, key) && !R->ties->preceed(key, k)) {//clés égales
+				struct heap_node_t removed = bucket_remove_at(B, j);
+				pool_free(R->ties->handles, removed.handle);
+				data = removed.data;
+				if (R->freeKey != NULL) {
+					R->freeKey(k);
+				}
+				break;
+			}
+		}
+	}
+	if (data != NULL) {
+		R->numelm--;
+	}
+	return data;
+}
+
+void * radix_heap_remove_handle(struct radix_heap_t * R, struct heap_handle_t * handle, void ** key) {
+	assert(R != NULL && handle != NULL);
+	R->numelm--;
+	if (handle->bucket == 0) {
+		return heap_remove_handle(R->ties, handle, key);
+	}
+	struct heap_node_t removed = bucket_remove_at(&R->buckets[handle->bucket], handle->index);
+	assert(removed.handle == handle);
+	pool_free(R->ties->handles, handle);
+	if (key != NULL) {
+		*key = removed.key;
+	} else if (R->freeKey != NULL) {
+		R->freeKey(removed.key);
+	}
+	return removed.data;
+}
@@ -4,73 +4,134 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <math.h>
+#include <limits.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "util.h"
-#include "list.h"
 #include "tree.h"
 #include "instance.h"
 
 /********************************************************************
- * schedule_node_t
+ * machine_schedule_t
  ********************************************************************/
 
+#define MACHINE_SCHEDULE_INITIAL_CAPACITY 16
+
 /**
- * @brief Construire et initialiser un nouveau nœud d'un ordonnancement.
+ * @brief Initialiser l'ordonnancement vide de machine \p MS.
  * 
- * @param[in] task 
- * @param[in] bt 
- * @param[in] et 
- * @return struct schedule_node_t* 
+ * @param[in] MS 
+ * @return int 1 si l'allocation a réussi, 0 sinon
  */
-static struct schedule_node_t * new_schedule_node(struct task_t * task, unsigned long bt, unsigned long et) {
-	assert(bt < et);//begin time doit être inférieur à end time
-	if (task == NULL) {//si la tâche est nulle
-		return NULL;//on renvoie NULL
+static int init_machine_schedule(struct machine_schedule_t * MS) {
+	MS->size = 0;
+	MS->capacity = MACHINE_SCHEDULE_INITIAL_CAPACITY;
+	MS->tasks = (struct task_t **) malloc(MS->capacity * sizeof(struct task_t *));
+	MS->begin_times = (unsigned long *) malloc(MS->capacity * sizeof(unsigned long));
+	MS->end_times = (unsigned long *) malloc(MS->capacity * sizeof(unsigned long));
+	if (!MS->tasks || !MS->begin_times || !MS->end_times) {
+		free(MS->tasks);
+		free(MS->begin_times);
+		free(MS->end_times);
+		return 0;
 	}
-	struct schedule_node_t * snode = (struct schedule_node_t *) malloc(sizeof(struct schedule_node_t));//on alloue de la mémoire pour le nœud
-	if (snode == NULL) {//si l'allocation a échoué
-		return NULL;//on renvoie NULL
-	}
-	snode->task = task;//on initialise task du nœud
-	snode->begin_time = bt;//on initialise begin_time du nœud
-	snode->end_time = et;//on initialise end_time du nœud
-	return snode;//on renvoie le nœud
-}
-
-struct task_t * get_schedule_node_task(const struct schedule_node_t * snode) {
-	return snode->task;
+	return 1;
 }
 
-unsigned long get_schedule_node_begin_time(const struct schedule_node_t * snode) {
-	return snode->begin_time;
+/**
+ * @brief Libérer les colonnes de l'ordonnancement de machine \p MS (les tâches ne sont pas libérées).
+ * 
+ * @param[in] MS 
+ */
+static void free_machine_schedule(struct machine_schedule_t * MS) {
+	free(MS->tasks);
+	free(MS->begin_times);
+	free(MS->end_times);
 }
 
-unsigned long get_schedule_node_end_time(const struct schedule_node_t * snode) {
-	return snode->end_time;
+/**
+ * @brief Ajouter le segment (\p task, \p bt, \p et) à la fin de l'ordonnancement de machine \p MS,
+ * en doublant la capacité des colonnes si elles sont pleines.
+ * 
+ * @param[in] MS 
+ * @param[in] task 
+ * @param[in] bt 
+ * @param[in] et 
+ */
+static void machine_schedule_push(struct machine_schedule_t * MS, struct task_t * task, unsigned long bt, unsigned long et) {
+	if (MS->size == MS->capacity) {
+		int capacity = 2 * MS->capacity;
+		struct task_t ** tasks = (struct task_t **) realloc(MS->tasks, capacity * sizeof(struct task_t *));
+		if (tasks == NULL) {
+			ShowMessage("src.schedule.c:machine_schedule_push : allocation impossible", 1);
+		}
+		MS->tasks = tasks;
+		unsigned long * begin_times = (unsigned long *) realloc(MS->begin_times, capacity * sizeof(unsigned long));
+		if (begin_times == NULL) {
+			ShowMessage("src.schedule.c:machine_schedule_push : allocation impossible", 1);
+		}
+		MS->begin_times = begin_times;
+		unsigned long * end_times = (unsigned long *) realloc(MS->end_times, capacity * sizeof(unsigned long));
+		if (end_times == NULL) {
+			ShowMessage("src.schedule.c:machine_schedule_push : allocation impossible", 1);
+		}
+		MS->end_times = end_times;
+		MS->capacity = capacity;
+	}
+	MS->tasks[MS->size] = task;
+	MS->begin_times[MS->size] = bt;
+	MS->end_times[MS->size] = et;
+	MS->size++;
 }
 
-void set_schedule_node_begin_time(struct schedule_node_t * snode, unsigned long new_bt) {
-	snode->begin_time = new_bt;
+int get_machine_schedule_size(const struct machine_schedule_t * MS) {
+	return MS->size;
 }
 
-void set_schedule_node_end_time(struct schedule_node_t * snode, unsigned long new_et) {
-	snode->end_time = new_et;
+struct task_t * get_machine_schedule_task(const struct machine_schedule_t * MS, int i) {
+	assert(i >= 0 && i < MS->size);
+	return MS->tasks[i];
 }
 
-void view_schedule_node(const void * snode) {
-	printf("Task %s \n, begin time %lu\n, end time %lu\n)", get_task_id(get_schedule_node_task(snode)), get_schedule_node_begin_time(snode), get_schedule_node_end_time(snode));//on affiche les informations du nœud
+unsigned long get_machine_schedule_begin_time(const struct machine_schedule_t * MS, int i) {
+	assert(i >= 0 && i < MS->size);
+	return MS->begin_times[i];
 }
 
-void delete_schedule_node(void * snode) {
-	if(snode != NULL) {//si le nœud n'est pas nul
-		free(snode);//on libère la mémoire
-	}
+unsigned long get_machine_schedule_end_time(const struct machine_schedule_t * MS, int i) {
+	assert(i >= 0 && i < MS->size);
+	return MS->end_times[i];
 }
 
 /********************************************************************
  * schedule_t
  ********************************************************************/
 
+/**
+ * @brief
+ * Remplacer la date de fin de la machine \p machine par \p et dans les arbres tournoi de l'ordonnancement \p S,
+ * puis recalculer les minimums et les maximums de la feuille jusqu'à la racine.
+ *
+ * @param[in] S
+ * @param[in] machine
+ * @param[in] et
+ */
+static void set_machine_end_time(struct schedule_t * S, int machine, unsigned long et) {
+	int k = S->num_leaves + machine;
+	S->end_times[k] = et;
+	S->latest_end_times[k] = et;
+	for (k /= 2; k >= 1; k /= 2) {
+		S->end_times[k] = min(S->end_times[2 * k], S->end_times[2 * k + 1]);
+		S->latest_end_times[k] = max(S->latest_end_times[2 * k], S->latest_end_times[2 * k + 1]);
+	}
+}
+
 struct schedule_t * new_schedule(int num_m) {
     assert(num_m >= 1);
 
@@ -80,18 +141,52 @@ struct schedule_t * new_schedule(int num_m) {
     }
 
     S->num_machines = num_m;
-    S->schedule = (struct list_t **)malloc(num_m * sizeof(struct list_t *));
+    S->num_tasks = 0;
+    S->total_completion_time = 0;
+    S->total_flow_time = 0;
+    S->busy_time = 0;
+    S->mapping = NULL;
+    S->mapping_size = 0;
+    S->loaded_tasks = NULL;
+    S->loaded_segment_tasks = NULL;
+    S->sink = NULL;
+    S->sink_arg = NULL;
+    S->schedule = (struct machine_schedule_t *)malloc(num_m * sizeof(struct machine_schedule_t));
     if (!S->schedule) {
         free(S);
         return NULL;
     }
 
+    //arbre tournoi : toutes les machines sont libres dès la date 0
+    S->num_leaves = 1;
+    while (S->num_leaves < num_m) {
+        S->num_leaves *= 2;
+    }
+    S->end_times = (unsigned long *)malloc(2 * S->num_leaves * sizeof(unsigned long));
+    S->latest_end_times = (unsigned long *)malloc(2 * S->num_leaves * sizeof(unsigned long));
+    if (!S->end_times || !S->latest_end_times) {
+        free(S->end_times);
+        free(S->latest_end_times);
+        free(S->schedule);
+        free(S);
+        return NULL;
+    }
+    for (int k = 0; k < S->num_leaves; k++) {
+        S->end_times[S->num_leaves + k] = (k < num_m) ? 0 : ULONG_MAX;
+        S->latest_end_times[S->num_leaves + k] = 0;
+    }
+    for (int k = S->num_leaves - 1; k >= 1; k--) {
+        S->end_times[k] = min(S->end_times[2 * k], S->end_times[2 * k + 1]);
+        S->latest_end_times[k] = 0;
+    }
+
     for (int i = 0; i < num_m; i++) {
-        S->schedule[i] = new_list(view_schedule_node, delete_schedule_node);
-        if (!S->schedule[i]) {
+        if (!init_machine_schedule(&S->schedule[i])) {
             for (int j = 0; j < i; j++) {
-                delete_list(S->schedule[j], 1);
+                free_machine_schedule(&S->schedule[j]);
             }
+            free(S->end_times);
+            free(S->latest_end_times);
             free(S->schedule);
             free(S);
             return NULL;
@@ -101,9 +196,9 @@ struct schedule_t * new_schedule(int num_m) {
     return S;
 }
 
-struct list_t * get_schedule_of_machine(const struct schedule_t * S, const int machine) {
+struct machine_schedule_t * get_schedule_of_machine(const struct schedule_t * S, const int machine) {
 	assert(machine >= 0 && machine < S->num_machines);//on vérifie que la machine est bien dans l'ordonnancement
-	return S->schedule[machine];//on renvoie la liste de la machine
+	return &S->schedule[machine];//on renvoie l'ordonnancement de la machine
 }
 
 int get_num_machines(const struct schedule_t * S) {
@@ -117,112 +212,708 @@ void view_schedule(const struct schedule_t * S) {
     fprintf(stdout, "Schedule: %d machines", S->num_machines);
     for (int i = 0; i < S->num_machines; i++) {
         fprintf(stdout, "Machine %d\n", i);
-        for (struct list_node_t * temp = get_list_head(get_schedule_of_machine(S,i)); temp != NULL; temp = temp->successor) {
-            view_task(get_schedule_node_task(get_list_node_data(temp)));
+        const struct machine_schedule_t * MS = get_schedule_of_machine(S, i);
+        for (int j = 0; j < MS->size; j++) {
+            view_task(MS->tasks[j]);
             fprintf(stdout, "\n");
         }
     }
 }
 
 void delete_schedule(struct schedule_t * S) {
-	for(int i = 0; i < S->num_machines; i++){//on parcourt toutes les machines
-		delete_list(S->schedule[i],1);//on libère la mémoire de la liste de la machine i
+	if(S->mapping != NULL){//les colonnes pointent dans la projection du fichier
+		munmap(S->mapping, S->mapping_size);
+		free(S->loaded_tasks);
+		free(S->loaded_segment_tasks);
+	} else {
+		for(int i = 0; i < S->num_machines; i++){//on parcourt toutes les machines
+			free_machine_schedule(&S->schedule[i]);//on libère la mémoire des colonnes de la machine i
+		}
 	}
+	free(S->end_times);
+	free(S->latest_end_times);
+	free(S->schedule);
 	free(S);//on libère la mémoire
 }
 
+/********************************************************************
+ * Écriture tamponnée de l'ordonnancement
+ ********************************************************************/
+
+#define SAVE_BUFFER_SIZE (1 << 20)
+
+/**
+ * @brief 
+ * Un tampon d'écriture contient
+ * (+) le descripteur du fichier (fd),
+ * (+) le tableau de SAVE_BUFFER_SIZE octets (data), et
+ * (+) le nombre d'octets en attente d'écriture dans data (size).
+ */
+struct output_buffer_t {
+	int fd;
+	char * data;
+	size_t size;
+};
+
+/**
+ * @brief Écrire dans le fichier les octets en attente du tampon \p B, puis le vider.
+ * 
+ * @param[in] B 
+ */
+static void output_buffer_flush(struct output_buffer_t * B) {
+	size_t written = 0;
+	while (written < B->size) {//write peut écrire moins que demandé
+		ssize_t n = write(B->fd, B->data + written, B->size - written);
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			ShowMessage("src.schedule.c:output_buffer_flush : écriture impossible", 1);
+		}
+		written += (size_t) n;
+	}
+	B->size = 0;
+}
+
+/**
+ * @brief Ajouter les \p len octets de \p bytes au tampon \p B.
+ * 
+ * @param[in] B 
+ * @param[in] bytes 
+ * @param[in] len 
+ */
+static void output_buffer_write(struct output_buffer_t * B, const char * bytes, size_t len) {
+	while (len > 0) {
+		if (B->size == SAVE_BUFFER_SIZE) {
+			output_buffer_flush(B);
+		}
+		size_t n = min(len, SAVE_BUFFER_SIZE - B->size);
+		memcpy(B->data + B->size, bytes, n);
+		B->size += n;
+		bytes += n;
+		len -= n;
+	}
+}
+
+/**
+ * @brief Écrire dans \p text (au moins 21 octets) l'écriture décimale de \p value suivie du caractère \p sep
+ * (même texte que "%lu" de printf, sans l'analyse du format).
+ * 
+ * @param[out] text 
+ * @param[in] value 
+ * @param[in] sep 
+ * @return size_t le nombre d'octets écrits
+ */
+static size_t ulong_to_text(char * text, unsigned long value, char sep) {
+	char digits[24];
+	char * p = digits + sizeof(digits);
+	*--p = sep;
+	do {//les chiffres sont produits du moins significatif au plus significatif
+		*--p = (char) ('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+	size_t len = (size_t) (digits + sizeof(digits) - p);
+	memcpy(text, p, len);
+	return len;
+}
+
+/**
+ * @brief Ajouter au tampon \p B l'écriture décimale de \p value suivie du caractère \p sep (voir ulong_to_text).
+ * 
+ * @param[in] B 
+ * @param[in] value 
+ * @param[in] sep 
+ */
+static void output_buffer_write_ulong(struct output_buffer_t * B, unsigned long value, char sep) {
+	char digits[24];
+	output_buffer_write(B, digits, ulong_to_text(digits, value, sep));
+}
+
 // Pour le format du fichier à créer, regardez dans la présentation du cours.
 void save_schedule(struct schedule_t * S, char * filename) {
-	assert(filename == NULL);//on vérifie que le nom du fichier n'est pas nul
-	FILE * file = fopen(filename, "w");//on ouvre le fichier en écriture
-	if(file == NULL){//si l'ouverture a échoué
-		ShowMessage("Fichier impossible à ouvrir",1);//on affiche un message d'erreur
+	assert(filename != NULL);//on vérifie que le nom du fichier n'est pas nul
+	struct output_buffer_t B;
+	B.fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);//on ouvre le fichier en écriture
+	if(B.fd < 0){//si l'ouverture a échoué
+		ShowMessage("src.schedule.c:save_schedule : fichier impossible à ouvrir",1);//on affiche un message d'erreur
+	}
+	B.data = (char *) malloc(SAVE_BUFFER_SIZE);
+	if(B.data == NULL){
+		ShowMessage("src.schedule.c:save_schedule : allocation impossible",1);
 	}
-	fprintf(file, "%d\n", S->num_machines);//on écrit le nombre de machines dans le fichier
+	B.size = 0;
+	output_buffer_write_ulong(&B, (unsigned long) S->num_machines, '\n');//on écrit le nombre de machines dans le fichier
 	for(int i = 0; i < S->num_machines; i++){//on parcourt toutes les machines
-		struct list_t * list = S->schedule[i];//on récupère la liste de la machine i
-		struct list_node_t * node = get_list_head(list);//on récupère le premier nœud de la liste
-			while(node != NULL){//tant que le nœud n'est pas null
-                struct schedule_node_t * snode = get_list_node_data(node->data);//on récupère les données du nœud
-				fprintf(file, "%s %lu %lu\n", get_task_id(get_schedule_node_task(snode)), get_schedule_node_begin_time(snode), get_schedule_node_end_time(snode));//on écrit les informations du nœud dans le fichier
-				node = get_successor(node);//on passe au nœud suivant
+		const struct machine_schedule_t * MS = &S->schedule[i];//on récupère l'ordonnancement de la machine i
+		for(int j = 0; j < MS->size; j++){//on écrit "id begin_time end_time" pour chaque segment
+			const char * id = get_task_id(MS->tasks[j]);
+			output_buffer_write(&B, id, strlen(id));
+			output_buffer_write(&B, " ", 1);
+			output_buffer_write_ulong(&B, MS->begin_times[j], ' ');
+			output_buffer_write_ulong(&B, MS->end_times[j], '\n');
+		}
+	}
+	output_buffer_flush(&B);
+	free(B.data);
+	close(B.fd);//on ferme le fichier
+}
+
+/********************************************************************
+ * Ordonnancement en flux
+ ********************************************************************/
+
+struct output_buffer_t * new_schedule_writer(const char * filename) {
+	struct output_buffer_t * W = (struct output_buffer_t *) malloc(sizeof(struct output_buffer_t));
+	if (W == NULL) {
+		ShowMessage("src.schedule.c:new_schedule_writer : allocation impossible", 1);
+	}
+	W->fd = filename != NULL ? open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644) : STDOUT_FILENO;
+	if (W->fd < 0) {
+		ShowMessage("src.schedule.c:new_schedule_writer : fichier impossible à ouvrir", 1);
+	}
+	W->data = (char *) malloc(SAVE_BUFFER_SIZE);
+	if (W->data == NULL) {
+		ShowMessage("src.schedule.c:new_schedule_writer : allocation impossible", 1);
+	}
+	W->size = 0;
+	return W;
+}
+
+void write_schedule_segment(void * writer, int machine, const struct task_t * task, unsigned long bt, unsigned long et) {
+	struct output_buffer_t * W = writer;
+	const char * id = get_task_id(task);
+	output_buffer_write_ulong(W, (unsigned long) machine, ' ');
+	output_buffer_write(W, id, strlen(id));
+	output_buffer_write(W, " ", 1);
+	output_buffer_write_ulong(W, bt, ' ');
+	output_buffer_write_ulong(W, et, '\n');
+}
+
+void delete_schedule_writer(struct output_buffer_t * W) {
+	output_buffer_flush(W);
+	if (W->fd != STDOUT_FILENO) {
+		close(W->fd);
+	}
+	free(W->data);
+	free(W);
+}
+
+#define WRITER_MIN_BLOCK_SIZE 256
+
+/**
+ * @brief 
+ * Un écrivain tamponné au format de save_schedule (voir new_saved_schedule_writer) contient
+ * (+) le tampon (out) du fichier à écrire, qui reçoit l'en-tête dès la construction,
+ * (+) le nombre de machines (num_machines) et la taille des blocs (block_size),
+ * (+) le bloc en cours de chaque machine (blocks, num_machines * block_size octets) et son remplissage (filled),
+ * (+) le fichier temporaire (spill, NULL tant qu'aucun bloc n'est plein), et
+ * (+) la machine de chaque bloc écrit dans le fichier temporaire (spilled_machines, num_spilled blocs,
+ *     capacité spilled_capacity) : le k-ième bloc est à la position k * block_size.
+ */
+struct saved_schedule_writer_t {
+	struct output_buffer_t out;
+	int num_machines;
+	size_t block_size;
+	char * blocks;
+	size_t * filled;
+	FILE * spill;
+	int * spilled_machines;
+	size_t num_spilled;
+	size_t spilled_capacity;
+};
+
+struct saved_schedule_writer_t * new_saved_schedule_writer(const char * filename, int num_machines) {
+	assert(num_machines > 0);
+	struct saved_schedule_writer_t * W = (struct saved_schedule_writer_t *) malloc(sizeof(struct saved_schedule_writer_t));
+	if (W == NULL) {
+		ShowMessage("src.schedule.c:new_saved_schedule_writer : allocation impossible", 1);
+	}
+	W->out.fd = filename != NULL ? open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644) : STDOUT_FILENO;
+	if (W->out.fd < 0) {
+		ShowMessage("src.schedule.c:new_saved_schedule_writer : fichier impossible à ouvrir", 1);
+	}
+	W->out.data = (char *) malloc(SAVE_BUFFER_SIZE);
+	W->num_machines = num_machines;
+	W->block_size = max((size_t) WRITER_MIN_BLOCK_SIZE, (size_t) SAVE_BUFFER_SIZE / num_machines);
+	W->blocks = (char *) malloc(num_machines * W->block_size);
+	W->filled = (size_t *) calloc(num_machines, sizeof(size_t));
+	if (W->out.data == NULL || W->blocks == NULL || W->filled == NULL) {
+		ShowMessage("src.schedule.c:new_saved_schedule_writer : allocation impossible", 1);
+	}
+	W->out.size = 0;
+	output_buffer_write_ulong(&W->out, (unsigned long) num_machines, '\n');//même en-tête que save_schedule
+	W->spill = NULL;
+	W->spilled_machines = NULL;
+	W->num_spilled = 0;
+	W->spilled_capacity = 0;
+	return W;
+}
+
+/**
+ * @brief Écrire le bloc plein de la machine \p machine à la fin du fichier temporaire de \p W,
+ * noter sa machine et vider le bloc.
+ *
+ * @param[in] W
+ * @param[in] machine
+ */
+static void spill_machine_block(struct saved_schedule_writer_t * W, int machine) {
+	if (W->spill == NULL) {
+		W->spill = tmpfile();//supprimé à sa fermeture
+		if (W->spill == NULL) {
+			ShowMessage("src.schedule.c:write_saved_schedule_segment : fichier temporaire impossible à créer", 1);
+		}
+	}
+	if (W->num_spilled == W->spilled_capacity) {
+		W->spilled_capacity = W->spilled_capacity == 0 ? 64 : 2 * W->spilled_capacity;
+		W->spilled_machines = (int *) realloc(W->spilled_machines, W->spilled_capacity * sizeof(int));
+		if (W->spilled_machines == NULL) {
+			ShowMessage("src.schedule.c:write_saved_schedule_segment : allocation impossible", 1);
+		}
+	}
+	struct output_buffer_t B = { fileno(W->spill), W->blocks + machine * W->block_size, W->block_size };
+	output_buffer_flush(&B);
+	W->spilled_machines[W->num_spilled++] = machine;
+	W->filled[machine] = 0;
+}
+
+/**
+ * @brief Ajouter les \p len octets de \p bytes au bloc de la machine \p machine de \p W.
+ *
+ * @param[in] W
+ * @param[in] machine
+ * @param[in] bytes
+ * @param[in] len
+ */
+static void machine_block_write(struct saved_schedule_writer_t * W, int machine, const char * bytes, size_t len) {
+	char * block = W->blocks + machine * W->block_size;
+	while (len > 0) {
+		if (W->filled[machine] == W->block_size) {
+			spill_machine_block(W, machine);
+		}
+		size_t n = min(len, W->block_size - W->filled[machine]);
+		memcpy(block + W->filled[machine], bytes, n);
+		W->filled[machine] += n;
+		bytes += n;
+		len -= n;
+	}
+}
+
+void write_saved_schedule_segment(void * writer, int machine, const struct task_t * task, unsigned long bt, unsigned long et) {
+	struct saved_schedule_writer_t * W = writer;
+	assert(machine >= 0 && machine < W->num_machines);
+	const char * id = get_task_id(task);
+	char digits[48];
+	size_t len = ulong_to_text(digits, bt, ' ');
+	len += ulong_to_text(digits + len, et, '\n');
+	machine_block_write(W, machine, id, strlen(id));
+	machine_block_write(W, machine, " ", 1);
+	machine_block_write(W, machine, digits, len);
+}
+
+void delete_saved_schedule_writer(struct saved_schedule_writer_t * W) {
+	//Les blocs écrits dans le fichier temporaire sont rangés par machine (tri par dénombrement,
+	//qui garde leur ordre d'écriture), puis recopiés machine par machine avant le bloc en cours
+	size_t * first = (size_t *) calloc(W->num_machines + 1, sizeof(size_t));
+	size_t * order = (size_t *) malloc(max(W->num_spilled, (size_t) 1) * sizeof(size_t));
+	char * block = (char *) malloc(W->block_size);
+	if (first == NULL || order == NULL || block == NULL) {
+		ShowMessage("src.schedule.c:delete_saved_schedule_writer : allocation impossible", 1);
+	}
+	for (size_t k = 0; k < W->num_spilled; k++) {
+		first[W->spilled_machines[k] + 1]++;
+	}
+	for (int i = 0; i < W->num_machines; i++) {
+		first[i + 1] += first[i];
+	}
+	for (size_t k = 0; k < W->num_spilled; k++) {
+		order[first[W->spilled_machines[k]]++] = k;
+	}
+	size_t k = 0;
+	for (int i = 0; i < W->num_machines; i++) {
+		for (; k < W->num_spilled && W->spilled_machines[order[k]] == i; k++) {
+			size_t read = 0;
+			while (read < W->block_size) {//pread peut lire moins que demandé
+				ssize_t n = pread(fileno(W->spill), block + read, W->block_size - read,
+									(off_t) (order[k] * W->block_size + read));
+				if (n <= 0) {
+					if (n < 0 && errno == EINTR) {
+						continue;
+					}
+					ShowMessage("src.schedule.c:delete_saved_schedule_writer : lecture impossible", 1);
+				}
+				read += (size_t) n;
 			}
+			output_buffer_write(&W->out, block, W->block_size);
 		}
-		fclose(file);//on ferme le fichier
+		output_buffer_write(&W->out, W->blocks + i * W->block_size, W->filled[i]);
+	}
+	output_buffer_flush(&W->out);
+	if (W->out.fd != STDOUT_FILENO) {
+		close(W->out.fd);
+	}
+	if (W->spill != NULL) {
+		fclose(W->spill);
+	}
+	free(block);
+	free(order);
+	free(first);
+	free(W->spilled_machines);
+	free(W->filled);
+	free(W->blocks);
+	free(W->out.data);
+	free(W);
+}
+
+void set_schedule_sink(struct schedule_t * S,
+						void (*sink)(void * arg, int machine, const struct task_t * task, unsigned long bt, unsigned long et),
+						void * arg) {
+	assert(S != NULL && S->mapping == NULL);
+	S->sink = sink;
+	S->sink_arg = arg;
+}
+
+/**
+ * @brief Transmettre à la fonction de flux de \p S les \p count premiers segments de la machine \p machine,
+ * puis les retirer de son ordonnancement.
+ *
+ * @param[in] S
+ * @param[in] machine
+ * @param[in] count
+ */
+static void emit_segments(struct schedule_t * S, int machine, int count) {
+	struct machine_schedule_t * MS = &S->schedule[machine];
+	for (int j = 0; j < count; j++) {
+		S->sink(S->sink_arg, machine, MS->tasks[j], MS->begin_times[j], MS->end_times[j]);
+	}
+	for (int j = count; j < MS->size; j++) {//on décale les segments restants (au plus un)
+		MS->tasks[j - count] = MS->tasks[j];
+		MS->begin_times[j - count] = MS->begin_times[j];
+		MS->end_times[j - count] = MS->end_times[j];
+	}
+	MS->size -= count;
+}
+
+void flush_schedule(struct schedule_t * S) {
+	assert(S != NULL);
+	if (S->sink == NULL) {
+		return;
+	}
+	for (int i = 0; i < S->num_machines; i++) {
+		emit_segments(S, i, S->schedule[i].size);
+	}
 }
 
-// Trouver la machine qui est vide
+/********************************************************************
+ * Format binaire de l'ordonnancement
+ ********************************************************************/
+
+#define SCHEDULE_FILE_MAGIC "SCHEDBIN"
+#define SCHEDULE_FILE_VERSION 1UL
+
+/**
+ * @brief 
+ * L'en-tête du fichier binaire (voir save_schedule_binary).
+ */
+struct schedule_file_header_t {
+	char magic[8];
+	unsigned long version;
+	unsigned long num_machines;
+	unsigned long num_tasks;
+	unsigned long ids_size;
+	unsigned long scheduled_tasks;
+	unsigned long total_completion_time;
+	unsigned long total_flow_time;
+	unsigned long busy_time;
+};
+
+/**
+ * @brief 
+ * L'entrée d'une machine : son nombre de segments (size) et la position de ses colonnes (offset).
+ */
+struct schedule_file_machine_t {
+	unsigned long size;
+	unsigned long offset;
+};
+
+/**
+ * @brief 
+ * L'entrée d'une tâche : la position de son identifiant dans la table des identifiants (id_offset),
+ * sa durée et sa date de libération.
+ */
+struct schedule_file_task_t {
+	unsigned long id_offset;
+	unsigned long processing_time;
+	unsigned long release_time;
+};
+
+static int compare_task_pointers(const void * a, const void * b) {
+	uintptr_t x = (uintptr_t) *(struct task_t * const *) a;
+	uintptr_t y = (uintptr_t) *(struct task_t * const *) b;
+	return (x > y) - (x < y);
+}
+
+void save_schedule_binary(struct schedule_t * S, char * filename) {
+	assert(S != NULL && filename != NULL);
+	//Les tâches distinctes, triées par adresse : l'indice d'une tâche est sa position dans ce tableau
+	size_t num_segments = 0;
+	for (int i = 0; i < S->num_machines; i++) {
+		num_segments += S->schedule[i].size;
+	}
+	struct task_t ** tasks = (struct task_t **) malloc((num_segments + 1) * sizeof(struct task_t *));
+	if (tasks == NULL) {
+		ShowMessage("src.schedule.c:save_schedule_binary : allocation impossible", 1);
+	}
+	size_t num_tasks = 0;
+	for (int i = 0; i < S->num_machines; i++) {
+		memcpy(tasks + num_tasks, S->schedule[i].tasks, S->schedule[i].size * sizeof(struct task_t *));
+		num_tasks += S->schedule[i].size;
+	}
+	qsort(tasks, num_tasks, sizeof(struct task_t *), compare_task_pointers);
+	size_t k = 0;
+	for (size_t j = 0; j < num_tasks; j++) {
+		if (k == 0 || tasks[k - 1] != tasks[j]) {
+			tasks[k++] = tasks[j];
+		}
+	}
+	num_tasks = k;
+	unsigned long ids_size = 0;
+	for (size_t j = 0; j < num_tasks; j++) {
+		ids_size += strlen(get_task_id(tasks[j])) + 1;
+	}
+	ids_size = (ids_size + 7) & ~7UL;//les colonnes qui suivent restent alignées
+
+	struct output_buffer_t B;
+	B.fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (B.fd < 0) {
+		ShowMessage("src.schedule.c:save_schedule_binary : fichier impossible à ouvrir", 1);
+	}
+	B.data = (char *) malloc(SAVE_BUFFER_SIZE);
+	if (B.data == NULL) {
+		ShowMessage("src.schedule.c:save_schedule_binary : allocation impossible", 1);
+	}
+	B.size = 0;
+
+	struct schedule_file_header_t header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, SCHEDULE_FILE_MAGIC, sizeof(header.magic));
+	header.version = SCHEDULE_FILE_VERSION;
+	header.num_machines = S->num_machines;
+	header.num_tasks = num_tasks;
+	header.ids_size = ids_size;
+	header.scheduled_tasks = S->num_tasks;
+	header.total_completion_time = S->total_completion_time;
+	header.total_flow_time = S->total_flow_time;
+	header.busy_time = S->busy_time;
+	output_buffer_write(&B, (const char *) &header, sizeof(header));
+
+	unsigned long offset = sizeof(header) + S->num_machines * sizeof(struct schedule_file_machine_t)
+							+ num_tasks * sizeof(struct schedule_file_task_t) + ids_size;
+	for (int i = 0; i < S->num_machines; i++) {
+		struct schedule_file_machine_t entry = { S->schedule[i].size, offset };
+		output_buffer_write(&B, (const char *) &entry, sizeof(entry));
+		offset += 3 * S->schedule[i].size * sizeof(unsigned long);
+	}
+	unsigned long id_offset = 0;
+	for (size_t j = 0; j < num_tasks; j++) {
+		struct schedule_file_task_t entry = { id_offset, get_task_processing_time(tasks[j]), get_task_release_time(tasks[j]) };
+		output_buffer_write(&B, (const char *) &entry, sizeof(entry));
+		id_offset += strlen(get_task_id(tasks[j])) + 1;
+	}
+	for (size_t j = 0; j < num_tasks; j++) {
+		const char * id = get_task_id(tasks[j]);
+		output_buffer_write(&B, id, strlen(id) + 1);
+	}
+	output_buffer_write(&B, "\0\0\0\0\0\0\0", ids_size - id_offset);
+
+	for (int i = 0; i < S->num_machines; i++) {
+		const struct machine_schedule_t * MS = &S->schedule[i];
+		output_buffer_write(&B, (const char *) MS->begin_times, MS->size * sizeof(unsigned long));
+		output_buffer_write(&B, (const char *) MS->end_times, MS->size * sizeof(unsigned long));
+		for (int j = 0; j < MS->size; j++) {
+			struct task_t ** found = bsearch(&MS->tasks[j], tasks, num_tasks, sizeof(struct task_t *), compare_task_pointers);
+			unsigned long index = found - tasks;
+			output_buffer_write(&B, (const char *) &index, sizeof(index));
+		}
+	}
+	output_buffer_flush(&B);
+	free(B.data);
+	close(B.fd);
+	free(tasks);
+}
+
+struct schedule_t * load_schedule(const char * filename) {
+	assert(filename != NULL);
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0) {
+		ShowMessage("src.schedule.c:load_schedule : fichier impossible à ouvrir", 1);
+	}
+	struct stat st;
+	if (fstat(fd, &st) < 0 || (size_t) st.st_size < sizeof(struct schedule_file_header_t)) {
+		ShowMessage("src.schedule.c:load_schedule : fichier invalide", 1);
+	}
+	size_t size = st.st_size;
+	char * map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);//la projection reste valide après la fermeture
+	if (map == MAP_FAILED) {
+		ShowMessage("src.schedule.c:load_schedule : projection impossible", 1);
+	}
+
+	const struct schedule_file_header_t * header = (const struct schedule_file_header_t *) map;
+	if (memcmp(header->magic, SCHEDULE_FILE_MAGIC, sizeof(header->magic)) != 0 || header->version != SCHEDULE_FILE_VERSION
+		|| header->num_machines < 1 || header->num_machines > INT_MAX
+		|| header->num_machines > size / sizeof(struct schedule_file_machine_t)
+		|| header->num_tasks > size / sizeof(struct schedule_file_task_t)) {
+		ShowMessage("src.schedule.c:load_schedule : fichier invalide", 1);
+	}
+	//Les tailles sont vérifiées en entiers avant de former les pointeurs vers les tables
+	//(chaque terme est au plus size d'après le test précédent : la somme ne déborde pas)
+	size_t ids_position = sizeof(struct schedule_file_header_t)
+							+ header->num_machines * sizeof(struct schedule_file_machine_t)
+							+ header->num_tasks * sizeof(struct schedule_file_task_t);
+	if (ids_position > size || header->ids_size > size - ids_position) {
+		ShowMessage("src.schedule.c:load_schedule : fichier tronqué", 1);
+	}
+	const struct schedule_file_machine_t * machines = (const struct schedule_file_machine_t *) (header + 1);
+	const struct schedule_file_task_t * file_tasks = (const struct schedule_file_task_t *) (machines + header->num_machines);
+	const char * ids = map + ids_position;
+	//Chaque identifiant commence dans la table : il suffit que la table finisse par '\0'
+	//pour que get_task_id ne lise pas au-delà de la projection
+	if (header->num_tasks > 0 && (header->ids_size == 0 || ids[header->ids_size - 1] != '\0')) {
+		ShowMessage("src.schedule.c:load_schedule : fichier invalide", 1);
+	}
+
+	struct schedule_t * S = new_schedule((int) header->num_machines);
+	if (S == NULL) {
+		ShowMessage("src.schedule.c:load_schedule : allocation impossible", 1);
+	}
+	S->mapping = map;
+	S->mapping_size = size;
+	S->num_tasks = header->scheduled_tasks;
+	S->total_completion_time = header->total_completion_time;
+	S->total_flow_time = header->total_flow_time;
+	S->busy_time = header->busy_time;
+
+	//Les tâches : leurs identifiants pointent dans la table des identifiants
+	S->loaded_tasks = (struct task_t *) malloc((header->num_tasks + 1) * sizeof(struct task_t));
+	size_t num_segments = 0;
+	for (int i = 0; i < S->num_machines; i++) {
+		if (machines[i].offset > size || machines[i].size > (size - machines[i].offset) / (3 * sizeof(unsigned long))
+			|| machines[i].size > INT_MAX) {
+			ShowMessage("src.schedule.c:load_schedule : fichier tronqué", 1);
+		}
+		if (machines[i].offset % sizeof(unsigned long) != 0) {//les colonnes sont lues sur place comme des unsigned long
+			ShowMessage("src.schedule.c:load_schedule : fichier invalide", 1);
+		}
+		num_segments += machines[i].size;
+	}
+	S->loaded_segment_tasks = (struct task_t **) malloc((num_segments + 1) * sizeof(struct task_t *));
+	if (S->loaded_tasks == NULL || S->loaded_segment_tasks == NULL) {
+		ShowMessage("src.schedule.c:load_schedule : allocation impossible", 1);
+	}
+	for (unsigned long j = 0; j < header->num_tasks; j++) {
+		if (file_tasks[j].id_offset >= header->ids_size) {
+			ShowMessage("src.schedule.c:load_schedule : fichier invalide", 1);
+		}
+		S->loaded_tasks[j].id = (char *) ids + file_tasks[j].id_offset;
+		S->loaded_tasks[j].processing_time = file_tasks[j].processing_time;
+		S->loaded_tasks[j].release_time = file_tasks[j].release_time;
+	}
+
+	//Les colonnes des machines : begin_times et end_times sont lues sur place
+	struct task_t ** segment_tasks = S->loaded_segment_tasks;
+	for (int i = 0; i < S->num_machines; i++) {
+		struct machine_schedule_t * MS = &S->schedule[i];
+		free_machine_schedule(MS);
+		MS->size = (int) machines[i].size;
+		MS->capacity = MS->size;
+		MS->begin_times = (unsigned long *) (map + machines[i].offset);
+		MS->end_times = MS->begin_times + MS->size;
+		const unsigned long * indices = MS->end_times + MS->size;
+		MS->tasks = segment_tasks;
+		for (int j = 0; j < MS->size; j++) {
+			if (indices[j] >= header->num_tasks) {
+				ShowMessage("src.schedule.c:load_schedule : fichier invalide", 1);
+			}
+			MS->tasks[j] = &S->loaded_tasks[indices[j]];
+		}
+		segment_tasks += MS->size;
+		if (MS->size > 0) {
+			set_machine_end_time(S, i, MS->end_times[MS->size - 1]);
+		}
+	}
+	return S;
+}
+
+// Trouver la machine qui est vide : une machine est libre si sa dernière tâche finit au plus tard en time
 int find_empty_machine(struct schedule_t * S, unsigned long time) {
     assert(S != NULL);
 
-    for(int i = 0; i < S->num_machines; i++) {
-        struct list_t * list = S->schedule[i];
-        struct list_node_t * node = get_list_head(list);
-        while(node != NULL) {
-            struct schedule_node_t * snode = get_list_node_data(node);
-            if(snode->end_time > time) {
-                break;
-            }
-            node = get_successor(node);
-        }
-
-        if(node == NULL) {
-            return i;
-        }
+    if (S->end_times[1] > time) {//la plus petite date de fin est trop tardive
+        return -1;
     }
-
-    return -1;
+    int k = 1;
+    while (k < S->num_leaves) {//on descend vers le fils gauche dès qu'il contient une machine libre
+        k = (S->end_times[2 * k] <= time) ? 2 * k : 2 * k + 1;
+    }
+    return k - S->num_leaves;
 }
 
+// Trouver la machine dont la tâche en cours finit le plus tard, si elle reste plus longtemps que la nouvelle tâche
 int find_machine_to_interrupt(struct schedule_t * S, unsigned long time, unsigned long processing_time) {
-	assert(S != NULL && time > 0 && processing_time > 0);
+	assert(S != NULL && processing_time > 0);
 
-    int stop = -1;
-    for (int i = 0; i < S->num_machines; i++) {
-        struct list_t *machine = *(S->schedule + i);
-
-        if (machine != NULL && !list_is_empty(machine)) {
-            struct list_node_t *node = get_list_head(machine);
-
-            while (node != NULL) {
-                struct schedule_node_t *schedule_node = get_list_node_data(node);
-                unsigned long remaining_time = time - schedule_node->end_time;
-                if (processing_time <= remaining_time) {
-                    if (stop == -1) {
-                        stop = i;
-                    } else {
-                        struct list_node_t *stop_node = get_list_head(*(S->schedule + stop));
-                        struct schedule_node_t *stop_schedule_node = get_list_node_data(stop_node);
-                        if (schedule_node->end_time > stop_schedule_node->end_time) {
-                            stop = i;
-                        }
-                    }
-                    break; // Sortir de la boucle dès qu'une machine peut être interrompue
-                }
-
-                node = get_successor(node);
-            }
-        }
+    unsigned long latest = S->latest_end_times[1];
+    if (latest <= time || latest - time <= processing_time) {//même la tâche la plus longue n'est pas à interrompre
+        return -1;
     }
-
-    return stop;
+    int k = 1;
+    while (k < S->num_leaves) {//on descend vers le fils gauche s'il contient le maximum
+        k = (S->latest_end_times[2 * k] == latest) ? 2 * k : 2 * k + 1;
+    }
+    return k - S->num_leaves;
 }
 
 void add_task_to_schedule(struct schedule_t * S, struct task_t * task, int machine, unsigned long bt, unsigned long et) {
-	assert(machine >= 0 || machine < S->num_machines);//on vérifie que la machine est valide
+	assert(machine >= 0 && machine < S->num_machines);//on vérifie que la machine est valide
 	assert(bt < et);//on vérifie que le temps de début est inférieur au temps de fin
-	list_insert_last(S->schedule[machine], new_schedule_node(task, bt, et));//on ajoute la tache en fin de liste de la machine
+	assert(task != NULL);
+	if (S->mapping != NULL) {
+		ShowMessage("src.schedule.c:add_task_to_schedule : ordonnancement chargé en lecture seule", 1);
+	}
+	if (S->sink != NULL && S->schedule[machine].size > 1) {//seul le dernier segment peut encore être modifié
+		emit_segments(S, machine, S->schedule[machine].size - 1);
+	}
+	machine_schedule_push(&S->schedule[machine], task, bt, et);//on ajoute la tache à la fin de l'ordonnancement de la machine
+	set_machine_end_time(S, machine, et);
+	//la tâche finit en et tant qu'elle n'est pas interrompue
+	S->num_tasks++;
+	S->total_completion_time += et;
+	S->total_flow_time += et - get_task_release_time(task);
+	S->busy_time += et - bt;
 }
 
 unsigned long preempt_task(struct schedule_t * S, int machine, unsigned long new_et) {
+    if (S->mapping != NULL) {
+        ShowMessage("src.schedule.c:preempt_task : ordonnancement chargé en lecture seule", 1);
+    }
     if(machine >= 0 && machine < S->num_machines){
-    	struct list_t * list = S->schedule[machine];
-    	struct list_node_t * node = get_list_tail(list);
-    	if(node != NULL){
-    	    struct schedule_node_t * snode = get_list_node_data(node);
-    	    unsigned long old_et = get_schedule_node_end_time(snode);
-    	    set_schedule_node_end_time(snode, new_et);
-            set_schedule_node_begin_time(snode, new_et - get_task_processing_time(get_schedule_node_task(snode)));
+    	struct machine_schedule_t * MS = &S->schedule[machine];
+    	if(MS->size > 0){
+    	    int last = MS->size - 1;
+    	    unsigned long old_et = MS->end_times[last];
+            //la tâche interrompue ne finit plus en old_et
+            S->num_tasks--;
+            S->total_completion_time -= old_et;
+            S->total_flow_time -= old_et - get_task_release_time(MS->tasks[last]);
+            if (new_et <= MS->begin_times[last]) {//la tâche n'a pas encore commencé : on retire son segment
+                S->busy_time -= old_et - MS->begin_times[last];
+                MS->size--;
+                set_machine_end_time(S, machine, MS->size > 0 ? MS->end_times[MS->size - 1] : 0);
+                return old_et;
+            }
+    	    S->busy_time -= old_et - new_et;
+    	    MS->end_times[last] = new_et;
+            set_machine_end_time(S, machine, new_et);
             return old_et;
         }
 	}
@@ -231,17 +922,20 @@ unsigned long preempt_task(struct schedule_t * S, int machine, unsigned long new
 
 unsigned long get_makespan(struct schedule_t * S) {
 	assert(S != NULL);//on vérifie que l'ordonnancement n'est pas null
-	unsigned long makespan = 0;//on initialise la variable makespan à 0
-	for(int i = 0; i < S->num_machines; i++){//on parcourt toutes les machines
-		struct list_t * list = S->schedule[i];//on récupère la liste de la machine i
-		struct list_node_t * node = get_list_tail(list);//on récupère le dernier élément de la liste
-		if(node != NULL){//si la liste n'est pas vide
-			struct schedule_node_t * snode = get_list_node_data(node);//on récupère les données du nœud
-            unsigned long end_time = get_schedule_node_end_time(snode);//on récupère le temps de fin de la tâche
-			if(end_time > makespan){//si le temps de fin de la tâche est supérieur au makespan
-				makespan = end_time;//on affecte à makespan le temps de fin de la tâche
-			}
-		}
-	}
-	return makespan;//on retourne le makespan
-}
\ No newline at end of file
+	return S->latest_end_times[1];//la racine contient la plus grande date de fin des machines
+}
+
+struct schedule_metrics_t get_schedule_metrics(const struct schedule_t * S) {
+	assert(S != NULL);
+	struct schedule_metrics_t metrics;
+	metrics.num_tasks = S->num_tasks;
+	metrics.makespan = S->latest_end_times[1];
+	metrics.total_completion_time = S->total_completion_time;
+	metrics.total_flow_time = S->total_flow_time;
+	metrics.mean_flow_time = S->num_tasks > 0 ? (double) S->total_flow_time / S->num_tasks : 0.0;
+	metrics.busy_time = S->busy_time;
+	unsigned long capacity = (unsigned long) S->num_machines * metrics.makespan;
+	metrics.idle_time = capacity - S->busy_time;
+	metrics.utilization = capacity > 0 ? (double) S->busy_time / capacity : 0.0;
+	return metrics;
+}
@@ -1,3 +1,4 @@
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -8,8 +9,29 @@
 #include "instance.h"
 #include "schedule.h"
 #include "algo.h"
+#include "event_queue.h"
+#include "btree.h"
+#include "validator.h"
 
-static int compare_lists(struct list_t *l1, double* l2[], int size) {
+/**
+ * @brief Nombre de vérifications qui ont échoué (voir check).
+ */
+static int failures = 0;
+
+/**
+ * @brief Afficher un message si la condition \p ok n'est pas vérifiée dans le test \p test.
+ *
+ * @param[in] ok
+ * @param[in] test
+ */
+static void check(int ok, const char * test) {
+	if (!ok) {
+		printf("problème : %s\n", test);
+		failures++;
+	}
+}
+
+static int compare_lists(struct list_t *l1, int* l2[], int size) {
 	if (get_list_size(l1) != size)
 		return 0;
 
@@ -49,181 +71,956 @@ void test_list_insert_last() {
 	tab[0] = i1; tab[1] = i2; tab[2] = i3;
 
 	list_insert_last(L, i1);
-	if (compare_lists(L, tab, 1) == 0) printf("problème");
+	check(compare_lists(L, tab, 1), "test_list_insert_last");
 	list_insert_last(L, i2);
-	if (compare_lists(L, tab, 2) == 0) printf("problème");
+	check(compare_lists(L, tab, 2), "test_list_insert_last");
 	list_insert_last(L, i3);
-	if (compare_lists(L, tab, 3) == 0) printf("problème");
+	check(compare_lists(L, tab, 3), "test_list_insert_last");
 
-	// Il manque la libération de la mémoire. C'est à vous !
-	free(i1);
-	free(i2);
-	free(i3);
+	delete_list(L, 1);//libère aussi i1, i2 et i3
 }
-void test_list_insert_last() {
-	int *i1 = malloc(sizeof(int));
-	int *i2 = malloc(sizeof(int));
-	int *i3 = malloc(sizeof(int));
-	*i1 = 1;
-	*i2 = 2;
-	*i3 = 3;
 
-	struct list_t * L = new_list(viewInt, freeInt);
-	int* tab[3];
-	tab[0] = i1; tab[1] = i2; tab[2] = i3;
+/**
+ * @brief
+ * Construire un arbre AVL d'entiers en insérant les \p n clés de \p keys dans cet ordre.
+ * Les clés sont des variables du test : l'arbre ne les libère pas.
+ *
+ * @param[in] keys
+ * @param[in] n
+ * @return struct tree_t*
+ */
+static struct tree_t * new_int_tree(int * keys, int n) {
+	struct tree_t * T = new_tree(TREE_AVL, intSmallerThan, viewInt, NULL, NULL, NULL);
+	for (int i = 0; i < n; i++) {
+		tree_insert(T, &keys[i], &keys[i]);
+	}
+	return T;
+}
 
-	list_insert_last(L, i1);
-	if (compare_lists(L, tab, 1) == 0) printf("problème");
-	list_insert_last(L, i2);
-	if (compare_lists(L, tab, 2) == 0) printf("problème");
-	list_insert_last(L, i3);
-	if (compare_lists(L, tab, 3) == 0) printf("problème");
-
-	// Il manque la libération de la mémoire. C'est à vous !
-	free(i1);
-	free(i2);
-	free(i3);
-}
-void test_arbre_non_equilibre_rotate_left(){
-	struct tree_node_t * racine = new_tree_node(5);
-	racine->left = new_tree_node(4);
-	racine->left->left = new_tree_node(3);
-	racine->left->right = new_tree_node(2);
-	racine->right = new_tree_node(6);
-	racine = rotate_left(racine->left);//rotation sur le noeud 4
-	view_tree(racine);
-	//Vérification de l'arbre résultant 
-	// Le résultat attendu est :
-	//     5
-	//    / \	
-	//   3   6
-	//  / \
-	// 2   4
-
-	free_tree(racine);
+/**
+ * @brief Restitue la clé entière du nœud \p node, ou -1 si le nœud est vide.
+ *
+ * @param[in] node
+ * @return int
+ */
+static int int_key(const struct tree_node_t * node) {
+	return (node == NULL) ? -1 : *(int *) get_tree_node_key(node);
 }
 
 void test_arbre_equilibre_rotate_left(){
-	struct tree_node_t * racine = new_tree_node(5);
-	racine->left = new_tree_node(3);
-	racine->left->left = new_tree_node(2);
-	racine->left->right = new_tree_node(4);
-	racine->right = new_tree_node(7);
-	racine->right->left = new_tree_node(6);
-	racine->right->right = new_tree_node(8);
-	racine = rotate_left();//rotation sur le noeud 7
-	view_tree(racine);
-
+	int keys[] = { 1, 2, 3 };
+	struct tree_t * T = new_int_tree(keys, 3);//l'insertion de 3 déséquilibre 1 à droite
 	//Vérification de l'arbre résultant
-	// Le résultat attendu est :
-	//     5
-	//    / \
-	//   3   6
-	//  / \   \
-	// 2   4   7
-	//          \
-	//           8
-
-	free_tree(racine);
-}
-void test_arbre_non_equilibre_facteurmoins2_rotate_left(){
-	struct tree_node_t * racine = new_tree_node(6);
-	racine->left = new_tree_node(5);
-	racine->left->left = new_tree_node(4);
-	racine->left->right = new_tree_node(3);
-	racine->left->right->left = new_tree_node(2);
-	racine->left->right->right = new_tree_node(1);
-	racine = rotate_left();//rotation sur le noeud 5
-	view_tree(racine);
+	/*
+	 * Le résultat attendu est :
+	 *     2
+	 *    / \
+	 *   1   3
+	 */
+	struct tree_node_t * racine = get_root(T);
+	check(int_key(racine) == 2 && int_key(get_left(racine)) == 1 && int_key(get_right(racine)) == 3,
+		"test_arbre_equilibre_rotate_left");
+	check(get_parent(get_left(racine)) == racine && get_parent(racine) == NULL, "test_arbre_equilibre_rotate_left");
+	delete_tree(T, 0, 0);
+}
 
+void test_arbre_equilibre_rotate_right(){
+	int keys[] = { 5, 3, 7, 2, 4, 1 };
+	struct tree_t * T = new_int_tree(keys, 6);//l'insertion de 1 déséquilibre 5 à gauche
 	//Vérification de l'arbre résultant
-	// Le résultat attendu est :
-	//	   6
-	//	  / \
-	//   4   7
-	//    \   
-	//     5
-	//      \
-	//       3
-	//      / \
-	//     2   1 
-	
-	free_tree(racine);     
-}
-
-void test_arbre_non_equilibre_rotate_right(){
-	struct tree_node_t * racine = new_tree_node(5);
-	racine->left = new_tree_node(4);
-	racine->left->right = new_tree_node(2);
-	racine->right = new_tree_node(6);
-	racine = rotate_right(racine->left);//rotation sur le noeud 5
-	view_tree(racine);
-	//Vérification de l'arbre résultant 
-	// Le résultat attendu est :
-	//     4
-	//      \	
-	//       5
-	//      / \
-	//     2   6
-
-	free_tree(racine);
+	/*
+	 * Le résultat attendu est :
+	 *       3
+	 *      / \
+	 *     2   5
+	 *    /   / \
+	 *   1   4   7
+	 */
+	struct tree_node_t * racine = get_root(T);
+	check(int_key(racine) == 3 && int_key(get_left(racine)) == 2 && int_key(get_right(racine)) == 5,
+		"test_arbre_equilibre_rotate_right");
+	check(int_key(get_left(get_left(racine))) == 1 && int_key(get_left(get_right(racine))) == 4
+		&& int_key(get_right(get_right(racine))) == 7, "test_arbre_equilibre_rotate_right");
+	delete_tree(T, 0, 0);
 }
 
-void test_arbre_equilibre_rotate_right(){
-	struct tree_node_t * racine = new_tree_node(5);
-	racine->left = new_tree_node(3);
-	racine->left->left = new_tree_node(2);
-	racine->left->right = new_tree_node(4);
-	racine->right = new_tree_node(7);
-	racine->right->left = new_tree_node(6);
-	racine->right->right = new_tree_node(8);
-	racine = rotate_right(racine->left);//rotation sur le noeud 3
-	view_tree(racine);
+void test_arbre_equilibre_double_rotation(){
+	int keys[] = { 6, 4, 5 };
+	struct tree_t * T = new_int_tree(keys, 3);//5 est inséré à droite du fils gauche : rotation gauche-droite
+	struct tree_node_t * racine = get_root(T);
+	check(int_key(racine) == 5 && int_key(get_left(racine)) == 4 && int_key(get_right(racine)) == 6,
+		"test_arbre_equilibre_double_rotation");
+	delete_tree(T, 0, 0);
 
-	//Vérification de l'arbre résultant
-	// Le résultat attendu est :
-	//	       3
-	//	     /   \
-	//      2     5
-	//           / \
-	//          4   7
-	//             / \
-	//            6   8
-	free_tree(racine);
-}
-
-void test_arbre_non_equilibre_facteurmoins2_rotate_right(){
-	struct tree_node_t * racine = new_tree_node(6);
-	racine->left = new_tree_node(5);
-	racine->left->left = new_tree_node(4);
-	racine->left->right = new_tree_node(3);
-	racine->left->right->left = new_tree_node(2);
-	racine->left->right->right = new_tree_node(1);
-	racine = rotate_right(racine->left);//rotation sur le noeud 5
-	view_tree(racine);
+	int keys2[] = { 4, 6, 5 };
+	T = new_int_tree(keys2, 3);//rotation droite-gauche
+	racine = get_root(T);
+	check(int_key(racine) == 5 && int_key(get_left(racine)) == 4 && int_key(get_right(racine)) == 6,
+		"test_arbre_equilibre_double_rotation");
+	delete_tree(T, 0, 0);
+}
 
-	//Vérification de l'arbre résultant
-	// Le résultat attendu est :
-	//	   5	
-	//	  / \
-	//   4   6 
-	// 	    /   
-	//     3
-	//    / \
-	//   2   1   
+void test_arbre_non_equilibre_sans_rotation(){
+	int keys[] = { 1, 2, 3 };
+	struct tree_t * T = new_tree(TREE_BST, intSmallerThan, viewInt, NULL, NULL, NULL);
+	for (int i = 0; i < 3; i++) {
+		tree_insert(T, &keys[i], &keys[i]);
+	}
+	/*
+	 * Un arbre non-équilibré garde la forme d'un peigne :
+	 * 1
+	 *  \
+	 *   2
+	 *    \
+	 *     3
+	 */
+	struct tree_node_t * racine = get_root(T);
+	check(int_key(racine) == 1 && get_left(racine) == NULL && int_key(get_right(racine)) == 2
+		&& int_key(get_right(get_right(racine))) == 3, "test_arbre_non_equilibre_sans_rotation");
+	delete_tree(T, 0, 0);
+}
+
+/**
+ * @brief
+ * Restitue la hauteur du sous-arbre \p node (0 s'il est vide), ou -1 si ce sous-arbre d'un arbre AVL
+ * (\p avl vaut 1) n'est pas équilibré ou si un facteur d'équilibre ne vaut pas h(gauche) - h(droite).
+ *
+ * @param[in] node
+ * @param[in] avl
+ * @return int
+ */
+static int checked_height(const struct tree_node_t * node, int avl) {
+	if (node == NULL)
+		return 0;
+	int hl = checked_height(get_left(node), avl);
+	int hr = checked_height(get_right(node), avl);
+	if (hl < 0 || hr < 0)
+		return -1;
+	if ((get_left(node) != NULL && get_parent(get_left(node)) != node)
+			|| (get_right(node) != NULL && get_parent(get_right(node)) != node))
+		return -1;
+	if (avl && (hl - hr > 1 || hr - hl > 1 || get_bfactor(node) != hl - hr))
+		return -1;
+	return 1 + max(hl, hr);
+}
+
+/**
+ * @brief
+ * Renvoie 1 si le parcours infixe de l'arbre \p T donne exactement les \p n clés \p keys
+ * (les mêmes adresses, dans le même ordre), sinon renvoie 0.
+ *
+ * @param[in] T
+ * @param[in] keys
+ * @param[in] n
+ * @return int
+ */
+static int inorder_is(const struct tree_t * T, void ** keys, int n) {
+	int i = 0;
+	for (struct tree_node_t * node = tree_iter_begin(T); node != NULL; node = tree_iter_next(node), i++) {
+		if (i >= n || get_tree_node_key(node) != keys[i])
+			return 0;
+	}
+	return i == n && get_tree_size(T) == n;
+}
+
+void test_tree_build_from_sorted() {
+	//clés triées avec des doublons : l'arbre construit en O(n) doit être équilibré
+	//et garder les clés égales dans l'ordre du tableau
+	int n = 100;
+	int values[100];
+	void * keys[100];
+	for (int i = 0; i < n; i++) {
+		values[i] = i / 3;
+		keys[i] = &values[i];
+	}
+	check(tree_keys_are_sorted(keys, n, intSmallerThan), "test_tree_build_from_sorted");
+	int modes[] = { TREE_BST, TREE_AVL, TREE_RED_BLACK };
+	for (int k = 0; k < 3; k++) {
+		struct tree_t * T = new_tree(modes[k], intSmallerThan, viewInt, NULL, NULL, NULL);
+		tree_build_from_sorted(T, keys, keys, n);
+		check(inorder_is(T, keys, n), "test_tree_build_from_sorted");
+		int h = checked_height(get_root(T), modes[k] == TREE_AVL);
+		check(h == 7, "test_tree_build_from_sorted");//hauteur minimale pour 100 nœuds
+		check(int_key(get_tree_min_node(T)) == 0 && int_key(get_tree_max_node(T)) == 33, "test_tree_build_from_sorted");
+		int extra = 50;//l'arbre reste utilisable : une insertion après la construction
+		tree_insert(T, &extra, &extra);
+		check(get_tree_size(T) == n + 1 && checked_height(get_root(T), modes[k] == TREE_AVL) > 0,
+			"test_tree_build_from_sorted");
+		delete_tree(T, 0, 0);
+	}
+}
+
+/**
+ * @brief Compter les éléments visités par tree_range et s'arrêter au troisième si \p arg vaut 1.
+ *
+ * @param[in] key
+ * @param[in] data
+ * @param[in] arg
+ * @return int
+ */
+static int count_range(void * key, void * data, void * arg) {
+	(void) key;
+	(void) data;
+	int * counter = arg;
+	counter[1]++;
+	return !(counter[0] == 1 && counter[1] == 3);
+}
+
+void test_tree_iter_range() {
+	int values[50];
+	struct tree_t * T = new_tree(TREE_AVL, intSmallerThan, viewInt, NULL, NULL, NULL);
+	for (int i = 0; i < 50; i++) {//clés paires 0, 2, ..., 98 insérées dans le désordre
+		values[i] = (i * 17 % 50) * 2;
+		tree_insert(T, &values[i], &values[i]);
+	}
+	int expected = 0, ok = 1;
+	for (struct tree_node_t * node = tree_iter_begin(T); node != NULL; node = tree_iter_next(node)) {
+		ok = ok && int_key(node) == expected;
+		expected += 2;
+	}
+	check(ok && expected == 100, "test_tree_iter_range");
+
+	int key = 31;//première clé >= 31
+	check(int_key(tree_iter_begin_at(T, &key)) == 32, "test_tree_iter_range");
+	key = 40;
+	check(int_key(tree_iter_begin_at(T, &key)) == 40, "test_tree_iter_range");
+	key = 99;
+	check(tree_iter_begin_at(T, &key) == NULL, "test_tree_iter_range");
+
+	int lo = 10, hi = 20;
+	int counter[2] = { 0, 0 };
+	check(tree_range(T, &lo, &hi, count_range, counter) == 6 && counter[1] == 6, "test_tree_iter_range");//10, 12, ..., 20
+	counter[1] = 0;
+	check(tree_range(T, NULL, &hi, count_range, counter) == 11, "test_tree_iter_range");
+	counter[0] = 1;//arrêt au troisième élément
+	counter[1] = 0;
+	check(tree_range(T, &lo, NULL, count_range, counter) == 3, "test_tree_iter_range");
+	delete_tree(T, 0, 0);
+}
+
+/**
+ * @brief Poids d'une clé entière : sa valeur.
+ *
+ * @param[in] key
+ * @return unsigned long
+ */
+static unsigned long int_weight(const void * key) {
+	return *(const int *) key;
+}
+
+void test_tree_rank_select() {
+	int values[64];
+	struct tree_t * T = new_tree(TREE_AVL, intSmallerThan, viewInt, NULL, NULL, NULL);
+	tree_augment(T, int_weight);
+	for (int i = 0; i < 64; i++) {//clés 1, ..., 64 insérées dans le désordre
+		values[i] = 1 + (i * 37) % 64;
+		tree_insert(T, &values[i], &values[i]);
+	}
+	for (int i = 0; i < 64; i++) {//retrait des clés paires : restent 1, 3, ..., 63
+		if (values[i] % 2 == 0) {
+			tree_remove(T, &values[i]);
+		}
+	}
+	int ok = get_tree_size(T) == 32;
+	for (int k = 0; k < 32; k++) {
+		int key = 2 * k + 1;
+		ok = ok && int_key(tree_select(T, k)) == key;
+		ok = ok && tree_rank(T, &key) == k;
+		ok = ok && tree_prefix_sum(T, k) == (unsigned long) (k * k);//1 + 3 + ... + (2k-1)
+	}
+	int key = 64;
+	check(ok && tree_rank(T, &key) == 32 && tree_prefix_sum(T, 32) == 1024, "test_tree_rank_select");
+	delete_tree(T, 0, 0);
+}
+
+/**
+ * @brief Restitue la clé entière d'indice \p i du nœud \p node de l'arbre B+ \p B.
+ *
+ * @param[in] B
+ * @param[in] node
+ * @param[in] i
+ * @return int
+ */
+static int btree_int_key(const struct btree_t * B, const struct btree_node_t * node, int i) {
+	return *(const int *) ((const char *) node + B->keysOffset + i * B->keySize);
+}
+
+/**
+ * @brief
+ * Vérifier le sous-arbre \p node, de profondeur \p depth, de l'arbre B+ \p B dont les clés sont des entiers :
+ * nombre de clés entre capacity/2 (sauf la racine) et capacity, clés triées et comprises entre
+ * \p lo et \p hi, et toutes les feuilles à la profondeur *\p leafDepth (fixée par la première feuille).
+ *
+ * @param[in] B
+ * @param[in] node
+ * @param[in] depth
+ * @param[in,out] leafDepth
+ * @param[in] lo
+ * @param[in] hi
+ * @return int Le nombre d'éléments du sous-arbre, -1 si une propriété n'est pas vérifiée.
+ */
+static int btree_check_node(const struct btree_t * B, const struct btree_node_t * node, int depth, int * leafDepth,
+						long lo, long hi) {
+	if (node->numkeys > B->capacity || (node != B->root && node->numkeys < B->capacity / 2))
+		return -1;
+	for (int i = 0; i < node->numkeys; i++) {
+		int key = btree_int_key(B, node, i);
+		if (key < lo || key > hi || (i > 0 && key < btree_int_key(B, node, i - 1)))
+			return -1;
+	}
+	if (node->leaf) {
+		if (*leafDepth == -1)
+			*leafDepth = depth;
+		return (depth == *leafDepth) ? node->numkeys : -1;
+	}
+	int count = 0;
+	for (int i = 0; i <= node->numkeys; i++) {//les éléments du fils i sont entre les clés i-1 et i
+		long clo = (i == 0) ? lo : btree_int_key(B, node, i - 1);
+		long chi = (i == node->numkeys) ? hi : btree_int_key(B, node, i);
+		int c = btree_check_node(B, node->ptrs[i], depth + 1, leafDepth, clo, chi);
+		if (c < 0)
+			return -1;
+		count += c;
+	}
+	return count;
+}
+
+/**
+ * @brief
+ * Renvoie 1 si l'arbre B+ \p B vérifie ses propriétés (voir btree_check_node) et si la liste
+ * de ses feuilles donne ses éléments dans l'ordre croissant, sinon renvoie 0.
+ *
+ * @param[in] B
+ * @return int
+ */
+static int btree_is_valid(const struct btree_t * B) {
+	int leafDepth = -1;
+	if (btree_check_node(B, B->root, 0, &leafDepth, -1, 1L << 40) != get_btree_size(B))
+		return 0;
+	int count = 0;
+	long last = -1;
+	for (const struct btree_node_t * leaf = B->first; leaf != NULL; leaf = leaf->next) {
+		for (int i = 0; i < leaf->numkeys; i++, count++) {
+			if (btree_int_key(B, leaf, i) < last)
+				return 0;
+			last = btree_int_key(B, leaf, i);
+		}
+	}
+	return count == get_btree_size(B);
+}
+
+void test_btree_split_merge() {
+	//assez de clés pour plusieurs niveaux de nœuds : les insertions coupent les nœuds,
+	//les suppressions empruntent aux voisins et fusionnent jusqu'à ramener la racine à une feuille
+	int n = 50000;
+	int * values = malloc(n * sizeof(int));
+	struct btree_t * B = new_btree(sizeof(int), intSmallerThan, viewInt, NULL, NULL);
+	for (int i = 0; i < n; i++) {
+		values[i] = (int) ((i * 7919L) % n);//une permutation de 0, ..., n-1
+		btree_insert(B, &values[i], &values[i]);
+		if (i % 10000 == 0) {
+			check(btree_is_valid(B), "test_btree_split_merge");
+		}
+	}
+	check(btree_is_valid(B) && !B->root->leaf && !((struct btree_node_t *) B->root->ptrs[0])->leaf,
+		"test_btree_split_merge");//au moins trois niveaux
+	int key = n / 2, missing = n;
+	check(*(int *) btree_find(B, &key) == n / 2 && btree_find(B, &missing) == NULL, "test_btree_split_merge");
+
+	int ok = 1;
+	for (int i = 0; i < n - 100; i++) {//suppressions dans un autre ordre que les insertions
+		key = (int) ((i * 104729L) % n);
+		int * data = btree_remove(B, &key);
+		ok = ok && data != NULL && *data == key;
+		if (i % 5000 == 0) {
+			check(btree_is_valid(B), "test_btree_split_merge");
+		}
+	}
+	check(ok && get_btree_size(B) == 100 && btree_is_valid(B) && B->root->leaf, "test_btree_split_merge");
+	int last = -1;
+	while (!btree_is_empty(B)) {
+		int * data = btree_pop_min(B);
+		ok = ok && *data > last;
+		last = *data;
+	}
+	check(ok, "test_btree_split_merge");
+	delete_btree(B, 0);
+	free(values);
+}
+
+/**
+ * @brief
+ * Lire l'instance décrite par le texte \p text (au format des fichiers data/instance)
+ * en passant par un fichier temporaire.
+ *
+ * @param[in] text
+ * @return Instance
+ */
+static Instance read_instance_text(const char * text) {
+	const char * filename = "test_instance.tmp";
+	FILE * fd = fopen(filename, "w");
+	if (fd == NULL) {
+		ShowMessage("src.test.c:read_instance_text : ouverture impossible", 1);
+	}
+	fputs(text, fd);
+	fclose(fd);
+	Instance I = read_instance(filename);
+	remove(filename);
+	return I;
+}
+
+/**
+ * @brief
+ * Renvoie 1 si la machine \p machine de l'ordonnancement \p S contient exactement
+ * les \p n segments décrits par \p ids, \p bt et \p et, dans cet ordre, sinon renvoie 0.
+ *
+ * @param[in] S
+ * @param[in] machine
+ * @param[in] ids
+ * @param[in] bt
+ * @param[in] et
+ * @param[in] n
+ * @return int
+ */
+static int machine_is(const struct schedule_t * S, int machine, const char * ids[],
+						const unsigned long bt[], const unsigned long et[], int n) {
+	struct machine_schedule_t * MS = get_schedule_of_machine(S, machine);
+	if (get_machine_schedule_size(MS) != n)
+		return 0;
+	for (int i = 0; i < n; i++) {
+		if (strcmp(get_task_id(get_machine_schedule_task(MS, i)), ids[i]) != 0
+				|| get_machine_schedule_begin_time(MS, i) != bt[i] || get_machine_schedule_end_time(MS, i) != et[i])
+			return 0;
+	}
+	return 1;
+}
+
+void test_schedule_preemption_at_time_zero() {
+	//b et a sont libérées en 0 alors que c occupe l'unique machine : la recherche d'une machine
+	//à interrompre a lieu en 0 (sans succès), puis d interrompt b en 1, avant qu'elle ait commencé
+	Instance I = read_instance_text("a 5 0\nb 3 0\nc 1 0\nd 1 1\n");
+	const char * ids[] = { "c", "d", "b", "a" };
+	unsigned long bt[] = { 0, 1, 2, 5 };
+	unsigned long et[] = { 1, 2, 5, 10 };
+	for (int bal = 0; bal <= 8; bal++) {
+		struct schedule_t * S = create_schedule(I, 1, 1, bal);
+		check(machine_is(S, 0, ids, bt, et, 4) && get_makespan(S) == 10, "test_schedule_preemption_at_time_zero");
+		delete_schedule(S);
+	}
+	delete_instance(I, 1);
+}
+
+/**
+ * @brief
+ * Écrire dans \p text (de taille suffisante) une instance de \p n tâches pseudo-aléatoires
+ * (générateur congruentiel de graine \p seed) : durées entre 1 et 4, dates de libération
+ * entre 0 et n/4, de sorte que beaucoup d'événements aient la même clé.
+ *
+ * @param[out] text
+ * @param[in] n
+ * @param[in] seed
+ */
+static void random_instance_text(char * text, int n, unsigned long seed) {
+	text[0] = '\0';
+	for (int i = 0; i < n; i++) {
+		seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+		unsigned long p = 1 + (seed >> 33) % 4;
+		seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+		unsigned long r = (seed >> 33) % (n / 4 + 1);
+		text += sprintf(text, "t%d %lu %lu\n", i, p, r);
+	}
+}
+
+/**
+ * @brief Renvoie 1 si les ordonnancements \p S1 et \p S2 ont exactement les mêmes segments, sinon renvoie 0.
+ *
+ * @param[in] S1
+ * @param[in] S2
+ * @return int
+ */
+static int same_schedules(const struct schedule_t * S1, const struct schedule_t * S2) {
+	if (get_num_machines(S1) != get_num_machines(S2))
+		return 0;
+	for (int m = 0; m < get_num_machines(S1); m++) {
+		struct machine_schedule_t * M1 = get_schedule_of_machine(S1, m);
+		struct machine_schedule_t * M2 = get_schedule_of_machine(S2, m);
+		if (get_machine_schedule_size(M1) != get_machine_schedule_size(M2))
+			return 0;
+		for (int i = 0; i < get_machine_schedule_size(M1); i++) {
+			if (get_machine_schedule_task(M1, i) != get_machine_schedule_task(M2, i)
+					|| get_machine_schedule_begin_time(M1, i) != get_machine_schedule_begin_time(M2, i)
+					|| get_machine_schedule_end_time(M1, i) != get_machine_schedule_end_time(M2, i))
+				return 0;
+		}
+	}
+	return 1;
+}
+
+void test_schedule_same_for_every_mode() {
+	//les clés égales sont servies dans l'ordre d'insertion par tous les ensembles d'événements :
+	//chaque valeur de balanced doit construire le même ordonnancement que l'arbre AVL
+	int n = 2000;
+	char * text = malloc(n * 32);
+	random_instance_text(text, n, 7);
+	Instance I = read_instance_text(text);
+	free(text);
+	int machines[] = { 1, 3, 10 };
+	for (int k = 0; k < 3; k++) {
+		for (int pre = 0; pre <= 1; pre++) {
+			struct schedule_t * ref = create_schedule(I, machines[k], pre, 1);
+			for (int bal = 0; bal <= 8; bal++) {
+				struct schedule_t * S = create_schedule(I, machines[k], pre, bal);
+				check(same_schedules(ref, S), "test_schedule_same_for_every_mode");
+				delete_schedule(S);
+			}
+			delete_schedule(ref);
+		}
+	}
+	delete_instance(I, 1);
+}
+
+/**
+ * @brief Clé des tests des ensembles d'événements : une date et le rang d'insertion (tag).
+ */
+struct test_event_t {
+	unsigned long time;
+	int tag;
+};
+
+/**
+ * @brief Comparer deux clés struct test_event_t par date seulement : les clés de même date sont égales.
+ *
+ * @param[in] a
+ * @param[in] b
+ * @return int
+ */
+static int test_event_preceed(const void * a, const void * b) {
+	return ((const struct test_event_t *) a)->time < ((const struct test_event_t *) b)->time;
+}
+
+/**
+ * @brief Restitue la date de la clé struct test_event_t \p key.
+ *
+ * @param[in] key
+ * @return unsigned long
+ */
+static unsigned long test_event_time(const void * key) {
+	return ((const struct test_event_t *) key)->time;
+}
+
+void test_event_queue_backends() {
+	//pour chaque implémentation : insertions avec des dates égales, retrait par référence
+	//d'un événement au milieu de ses égaux, puis extraction de tous les événements
+	unsigned long times[] = { 5, 3, 5, 1, 3, 5, 0, 3 };
+	int tags[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+	int n = 8;
+	int removed = 2;//le deuxième événement de date 5
+	for (int type = EVENT_QUEUE_BST; type <= EVENT_QUEUE_BTREE; type++) {
+		struct event_queue_t * EQ = new_event_queue(type, sizeof(struct test_event_t), test_event_preceed, test_event_time,
+												NULL, NULL, NULL, NULL);
+		void * handles[8];
+		for (int i = 0; i < n; i++) {
+			struct test_event_t key = { times[i], i };
+			handles[i] = event_queue_insert(EQ, &key, &tags[i]);
+		}
+		check(get_event_queue_size(EQ) == n, "test_event_queue_backends");
+		if (type != EVENT_QUEUE_BTREE) {//pas de référence dans un arbre B+ : on retire par clé
+			check(event_queue_remove_handle(EQ, handles[removed]) == &tags[removed], "test_event_queue_backends");
+		} else {
+			struct test_event_t key = { times[removed], removed };
+			event_queue_remove(EQ, &key);
+		}
+		check(get_event_queue_size(EQ) == n - 1, "test_event_queue_backends");
+
+		//ordre attendu : par date, puis par ordre d'insertion ; l'événement de tag 8 (date 4) est inséré
+		//après trois extractions (la file radix est monotone : sa date n'est pas avant la date 1 extraite).
+		//Pour l'arbre B+, event_queue_remove a retiré le premier égal (tag 0) au lieu du tag 2.
+		int expected[] = { 6, 3, 1, 4, 7, 8, 0, 5 };
+		if (type == EVENT_QUEUE_BTREE) {
+			expected[6] = 2;
+		}
+		int ok = 1;
+		for (int i = 0; i < n; i++) {
+			if (i == 3) {
+				struct test_event_t later = { 4, 8 };
+				event_queue_insert(EQ, &later, &tags[8]);
+			}
+			struct test_event_t * key = get_event_queue_min_key(EQ);
+			ok = ok && key->tag == expected[i];
+			ok = ok && event_queue_pop_min(EQ, NULL) == &tags[expected[i]];
+		}
+		check(ok && event_queue_is_empty(EQ), "test_event_queue_backends");
+		delete_event_queue(EQ, 0, 0);
+	}
+}
+
+void test_event_queue_stream_remove_handle() {
+	//flot : retrait d'un événement du flot trié (sans décalage) puis d'un événement du tas
+	int tags[] = { 0, 1, 2, 3, 4 };
+	struct event_queue_t * EQ = new_event_queue(EVENT_QUEUE_STREAM, sizeof(struct test_event_t), test_event_preceed, NULL,
+												NULL, NULL, NULL, NULL);
+	void * handles[5];
+	unsigned long times[] = { 4, 2, 2, 6 };
+	for (int i = 0; i < 4; i++) {
+		struct test_event_t key = { times[i], i };
+		handles[i] = event_queue_insert(EQ, &key, &tags[i]);
+	}
+	check(*(int *) get_event_queue_min_data(EQ) == 1, "test_event_queue_stream_remove_handle");//le flot est fermé
+	struct test_event_t key = { 2, 4 };
+	handles[4] = event_queue_insert(EQ, &key, &tags[4]);//va dans le tas
+	check(event_queue_remove_handle(EQ, handles[1]) == &tags[1], "test_event_queue_stream_remove_handle");//tête du flot
+	check(event_queue_remove_handle(EQ, handles[3]) == &tags[3], "test_event_queue_stream_remove_handle");//fin du flot
+	check(get_event_queue_size(EQ) == 3, "test_event_queue_stream_remove_handle");
+	check(event_queue_pop_min(EQ, NULL) == &tags[2], "test_event_queue_stream_remove_handle");
+	check(event_queue_remove_handle(EQ, handles[4]) == &tags[4], "test_event_queue_stream_remove_handle");
+	check(event_queue_pop_min(EQ, NULL) == &tags[0] && event_queue_is_empty(EQ), "test_event_queue_stream_remove_handle");
+	delete_event_queue(EQ, 0, 0);
+}
+
+/**
+ * @brief
+ * Renvoie 1 si l'ordonnancement chargé \p L a les mêmes segments que \p S : mêmes machines,
+ * même nombre de segments par machine et, pour chaque segment, même identifiant, même durée
+ * et même date de libération de tâche et mêmes dates de début et de fin, sinon renvoie 0.
+ * Les tâches de \p L sont reconstruites : on les compare par valeur.
+ *
+ * @param[in] S
+ * @param[in] L
+ * @return int
+ */
+static int same_loaded_schedule(const struct schedule_t * S, const struct schedule_t * L) {
+	if (get_num_machines(S) != get_num_machines(L))
+		return 0;
+	for (int m = 0; m < get_num_machines(S); m++) {
+		struct machine_schedule_t * MS = get_schedule_of_machine(S, m);
+		struct machine_schedule_t * ML = get_schedule_of_machine(L, m);
+		if (get_machine_schedule_size(MS) != get_machine_schedule_size(ML))
+			return 0;
+		for (int i = 0; i < get_machine_schedule_size(MS); i++) {
+			struct task_t * t1 = get_machine_schedule_task(MS, i);
+			struct task_t * t2 = get_machine_schedule_task(ML, i);
+			if (strcmp(get_task_id(t1), get_task_id(t2)) != 0
+					|| get_task_processing_time(t1) != get_task_processing_time(t2)
+					|| get_task_release_time(t1) != get_task_release_time(t2)
+					|| get_machine_schedule_begin_time(MS, i) != get_machine_schedule_begin_time(ML, i)
+					|| get_machine_schedule_end_time(MS, i) != get_machine_schedule_end_time(ML, i))
+				return 0;
+		}
+	}
+	return 1;
+}
+
+void test_schedule_binary_round_trip() {
+	//un ordonnancement avec préemption (une tâche a plusieurs segments) et des machines vides
+	const char * filename = "test_schedule.tmp";
+	int n = 500;
+	char * text = malloc(n * 32);
+	random_instance_text(text, n, 11);
+	Instance I = read_instance_text(text);
+	free(text);
+	int machines[] = { 1, 4, 600 };
+	for (int k = 0; k < 3; k++) {
+		struct schedule_t * S = create_schedule(I, machines[k], 1, 1);
+		save_schedule_binary(S, (char *) filename);
+		struct schedule_t * L = load_schedule(filename);
+		check(same_loaded_schedule(S, L), "test_schedule_binary_round_trip");
+		struct schedule_metrics_t a = get_schedule_metrics(S);
+		struct schedule_metrics_t b = get_schedule_metrics(L);
+		check(a.num_tasks == b.num_tasks && a.makespan == b.makespan
+				&& a.total_completion_time == b.total_completion_time && a.total_flow_time == b.total_flow_time
+				&& a.busy_time == b.busy_time && a.idle_time == b.idle_time, "test_schedule_binary_round_trip");
+		delete_schedule(L);
+		delete_schedule(S);
+	}
+	remove(filename);
+	delete_instance(I, 1);
+}
 
-	
-	free_tree(racine);     
+/**
+ * @brief Renvoie la tâche d'identifiant \p id de l'instance \p I (NULL si elle n'existe pas).
+ *
+ * @param[in] I
+ * @param[in] id
+ * @return struct task_t*
+ */
+static struct task_t * instance_task(Instance I, const char * id) {
+	for (struct list_node_t * node = get_list_head(I); node != NULL; node = get_successor(node)) {
+		if (strcmp(get_task_id(get_list_node_data(node)), id) == 0)
+			return get_list_node_data(node);
+	}
+	return NULL;
 }
 
+void test_validate_schedule_violations() {
+	//une machine par type de violation, plus une tâche a coupée entre les machines 0 et 6 (correcte)
+	Instance I = read_instance_text("a 3 0\nc 2 5\nd 2 0\ne 4 0\nf 2 0\ng 1 0\nh 1 0\n");
+	struct task_t * x = new_task("x", 2, 0);//hors de l'instance
+	struct schedule_t * S = new_schedule(7);
+	add_task_to_schedule(S, instance_task(I, "a"), 0, 0, 1);
+	add_task_to_schedule(S, x, 1, 0, 2);
+	add_task_to_schedule(S, instance_task(I, "g"), 2, 0, 1);
+	get_schedule_of_machine(S, 2)->end_times[0] = 0;//un segment vide ne peut être construit qu'à la main
+	add_task_to_schedule(S, instance_task(I, "c"), 3, 4, 6);
+	add_task_to_schedule(S, instance_task(I, "d"), 4, 0, 2);
+	add_task_to_schedule(S, instance_task(I, "e"), 4, 1, 5);
+	add_task_to_schedule(S, instance_task(I, "f"), 5, 0, 1);
+	add_task_to_schedule(S, instance_task(I, "a"), 6, 1, 3);
+	int types[] = { VIOLATION_NONE, VIOLATION_UNKNOWN_TASK, VIOLATION_EMPTY, VIOLATION_RELEASE,
+					VIOLATION_OVERLAP, VIOLATION_PROCESSING_TIME, VIOLATION_NONE };
+	int segments[] = { -1, 0, 0, 0, 1, 0, -1 };
+	const char * ids[] = { NULL, "x", "g", "c", "e", "f", NULL };
+	struct schedule_violation_t violations[7];
+	for (int threads = 1; threads <= 4; threads += 3) {
+		int unscheduled = -1;
+		check(validate_schedule(S, I, threads, violations, &unscheduled) == 5, "test_validate_schedule_violations");
+		check(unscheduled == 2, "test_validate_schedule_violations");//g (segment vide) et h
+		for (int m = 0; m < 7; m++) {
+			check(violations[m].type == types[m] && violations[m].segment == segments[m]
+					&& (ids[m] == NULL ? violations[m].task == NULL : strcmp(get_task_id(violations[m].task), ids[m]) == 0),
+					"test_validate_schedule_violations");
+		}
+	}
+	delete_schedule(S);
+	delete_task(x);
+	delete_instance(I, 1);
+}
+
+/**
+ * @brief
+ * Renvoie 1 si l'instance \p I contient, dans l'ordre, les tâches du fichier \p filename
+ * lues par un lecteur de référence (fscanf), sinon renvoie 0.
+ *
+ * @param[in] I
+ * @param[in] filename
+ * @return int
+ */
+static int same_as_reference_reader(Instance I, const char * filename) {
+	FILE * fd = fopen(filename, "r");
+	if (fd == NULL) {
+		ShowMessage("src.test.c:same_as_reference_reader : ouverture impossible", 1);
+	}
+	char id[64];
+	unsigned long p, r;
+	int same = 1;
+	struct list_node_t * node = get_list_head(I);
+	while (same && fscanf(fd, "%63s %lu %lu", id, &p, &r) == 3) {
+		struct task_t * task = node != NULL ? get_list_node_data(node) : NULL;
+		same = task != NULL && strcmp(get_task_id(task), id) == 0
+				&& get_task_processing_time(task) == p && get_task_release_time(task) == r;
+		node = node != NULL ? get_successor(node) : NULL;
+	}
+	fclose(fd);
+	return same && node == NULL;
+}
+
+void test_read_instance_like_reference() {
+	//blancs en tête, tabulations, fins de ligne CRLF, lignes vides, grandes valeurs
+	//et dernière ligne sans fin de ligne
+	const char * filename = "test_instance.tmp";
+	int n = 3000;
+	FILE * fd = fopen(filename, "w");
+	if (fd == NULL) {
+		ShowMessage("src.test.c:test_read_instance_like_reference : ouverture impossible", 1);
+	}
+	unsigned long seed = 3;
+	for (int i = 0; i < n; i++) {
+		seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+		unsigned long p = i % 97 == 0 ? ULONG_MAX : 1 + (seed >> 40);
+		unsigned long r = seed >> (i % 64);
+		fprintf(fd, "%s%s_%d%s%lu %lu%s", i % 5 == 0 ? "  " : "", i % 3 == 0 ? "tache" : "t", i,
+				i % 4 == 0 ? "\t" : " ", p, r, i == n - 1 ? "" : (i % 7 == 0 ? " \r\n" : "\n"));
+		if (i % 11 == 0) {
+			fputs("\n \t\n", fd);
+		}
+	}
+	fclose(fd);
+	Instance I = read_instance(filename);
+	check(get_list_size(I) == n && same_as_reference_reader(I, filename), "test_read_instance_like_reference");
+	delete_instance(I, 1);
+	int threads[] = { 1, 2, 3, 7, 64 };
+	for (int k = 0; k < 5; k++) {
+		I = read_instance_parallel(filename, threads[k]);
+		check(get_list_size(I) == n && same_as_reference_reader(I, filename), "test_read_instance_like_reference");
+		delete_instance(I, 1);
+	}
+	fd = fopen(filename, "w");//plus de morceaux que de lignes : des morceaux sont vides
+	fputs("a 1 0\n\nb 2 1\nc 3 2", fd);
+	fclose(fd);
+	I = read_instance_parallel(filename, 16);
+	check(get_list_size(I) == 3 && same_as_reference_reader(I, filename), "test_read_instance_like_reference");
+	delete_instance(I, 1);
+	fd = fopen(filename, "w");//fichier vide
+	fclose(fd);
+	I = read_instance_parallel(filename, 4);
+	check(get_list_size(I) == 0, "test_read_instance_like_reference");
+	delete_instance(I, 1);
+	remove(filename);
+}
+
+/**
+ * @brief Renvoie 1 si les fichiers \p f1 et \p f2 ont exactement le même contenu, sinon renvoie 0.
+ *
+ * @param[in] f1
+ * @param[in] f2
+ * @return int
+ */
+static int same_files(const char * f1, const char * f2) {
+	FILE * a = fopen(f1, "r");
+	FILE * b = fopen(f2, "r");
+	if (a == NULL || b == NULL) {
+		ShowMessage("src.test.c:same_files : ouverture impossible", 1);
+	}
+	int c1, c2;
+	do {
+		c1 = fgetc(a);
+		c2 = fgetc(b);
+	} while (c1 == c2 && c1 != EOF);
+	fclose(a);
+	fclose(b);
+	return c1 == c2;
+}
+
+void test_streamed_schedule_like_saved() {
+	//plus de SAVE_BUFFER_SIZE octets de segments : les blocs des machines passent par le fichier temporaire
+	int n = 100000;
+	char * text = malloc(n * 32);
+	random_instance_text(text, n, 13);
+	Instance I = read_instance_text(text);
+	free(text);
+	int machines[] = { 1, 10, 1000 };
+	for (int k = 0; k < 3; k++) {
+		for (int pre = 0; pre <= 1; pre++) {
+			struct schedule_t * S = create_schedule(I, machines[k], pre, 1);
+			save_schedule(S, "test_saved.tmp");
+			struct saved_schedule_writer_t * W = new_saved_schedule_writer("test_streamed.tmp", machines[k]);
+			struct schedule_t * T = create_schedule_streaming(I, machines[k], pre, 1, write_saved_schedule_segment, W);
+			delete_saved_schedule_writer(W);
+			check(same_files("test_saved.tmp", "test_streamed.tmp") && get_makespan(S) == get_makespan(T),
+					"test_streamed_schedule_like_saved");
+			delete_schedule(T);
+			delete_schedule(S);
+		}
+	}
+	remove("test_saved.tmp");
+	remove("test_streamed.tmp");
+	delete_instance(I, 1);
+}
+
+/**
+ * @brief Renvoie 1 si le fichier \p filename, écrit par new_schedule_writer (lignes "machine id begin end",
+ * machines mêlées), contient exactement les segments de \p S, dans l'ordre de chaque machine, sinon renvoie 0.
+ *
+ * @param[in] S
+ * @param[in] filename
+ * @return int
+ */
+static int same_as_streamed_lines(const struct schedule_t * S, const char * filename) {
+	FILE * f = fopen(filename, "r");
+	int num_m = get_num_machines(S);
+	int * next = calloc(num_m, sizeof(int));
+	if (f == NULL || next == NULL) {
+		ShowMessage("src.test.c:same_as_streamed_lines : ouverture impossible", 1);
+	}
+	int same = 1, machine;
+	char id[64];
+	unsigned long bt, et;
+	while (same && fscanf(f, "%d %63s %lu %lu", &machine, id, &bt, &et) == 4) {
+		if (machine < 0 || machine >= num_m) {
+			same = 0;
+			break;
+		}
+		struct machine_schedule_t * MS = get_schedule_of_machine(S, machine);
+		int i = next[machine]++;
+		same = i < get_machine_schedule_size(MS) && strcmp(id, get_task_id(get_machine_schedule_task(MS, i))) == 0
+				&& bt == get_machine_schedule_begin_time(MS, i) && et == get_machine_schedule_end_time(MS, i);
+	}
+	for (int m = 0; m < num_m && same; m++) {
+		same = next[m] == get_machine_schedule_size(get_schedule_of_machine(S, m));
+	}
+	fclose(f);
+	free(next);
+	return same;
+}
+
+void test_streamed_schedule_lines() {
+	//instance non triée (parcours d'un tableau trié des libérations), puis triée par libération
+	//et par durée (parcours de la liste) : le flux doit donner les segments de create_schedule
+	int n = 2000;
+	char * text = malloc(n * 32);
+	for (int sorted = 0; sorted <= 1; sorted++) {
+		if (sorted) {
+			char * t = text;
+			for (int i = 0; i < n; i++) {
+				t += sprintf(t, "t%d %d %d\n", i, 1 + (i % 8) / 2, i / 8);
+			}
+		} else {
+			random_instance_text(text, n, 17);
+		}
+		Instance I = read_instance_text(text);
+		for (int bal = 0; bal <= 8; bal++) {
+			for (int pre = 0; pre <= 1; pre++) {
+				struct schedule_t * S = create_schedule(I, 10, pre, bal);
+				struct output_buffer_t * W = new_schedule_writer("test_lines.tmp");
+				struct schedule_t * T = create_schedule_streaming(I, 10, pre, bal, write_schedule_segment, W);
+				delete_schedule_writer(W);
+				check(same_as_streamed_lines(S, "test_lines.tmp") && get_makespan(S) == get_makespan(T),
+						"test_streamed_schedule_lines");
+				delete_schedule(T);
+				delete_schedule(S);
+			}
+		}
+		delete_instance(I, 1);
+	}
+	free(text);
+	remove("test_lines.tmp");
+}
+
+void test_instance_remove_then_delete() {
+	//les nœuds et les tâches d'une instance lue par read_instance sont dans des blocs de l'instance :
+	//retirer des tâches (dont la première) puis supprimer l'instance ne doit ni libérer un mauvais
+	//pointeur ni perdre les blocs, quelle que soit deleteData
+	for (int deleteData = 0; deleteData <= 1; deleteData++) {
+		Instance I = read_instance_text("a 1 0\nb 2 0\nc 3 1\nd 4 2\n");
+		struct task_t * first = list_remove_first(I);
+		struct task_t * last = list_remove_last(I);
+		check(strcmp(get_task_id(first), "a") == 0 && strcmp(get_task_id(last), "d") == 0,
+				"test_instance_remove_then_delete");
+		list_insert_first(I, last);//nœud alloué hors du tableau
+		check(get_list_size(I) == 3 && strcmp(get_task_id(get_list_node_data(get_list_head(I))), "d") == 0
+				&& strcmp(get_task_id(get_list_node_data(get_list_tail(I))), "c") == 0,
+				"test_instance_remove_then_delete");
+		list_remove_first(I);
+		list_remove_first(I);
+		check(list_remove_first(I) != NULL && list_is_empty(I) && get_list_head(I) == NULL && get_list_tail(I) == NULL,
+				"test_instance_remove_then_delete");
+		delete_instance(I, deleteData);
+	}
+}
 
 int main() {
 	test_list_insert_last();
-	test_arbre_non_equilibre_rotate_left();
+	test_read_instance_like_reference();
+	test_instance_remove_then_delete();
 	test_arbre_equilibre_rotate_left();
-	test_arbre_non_equilibre_facteurmoins2_rotate_left();
-	test_arbre_non_equilibre_rotate_right();
 	test_arbre_equilibre_rotate_right();
-	test_arbre_non_equilibre_facteurmoins2_rotate_right();
+	test_arbre_equilibre_double_rotation();
+	test_arbre_non_equilibre_sans_rotation();
+	test_tree_build_from_sorted();
+	test_tree_iter_range();
+	test_tree_rank_select();
+	test_btree_split_merge();
+	test_event_queue_backends();
+	test_event_queue_stream_remove_handle();
+	test_schedule_preemption_at_time_zero();
+	test_schedule_same_for_every_mode();
+	test_schedule_binary_round_trip();
+	test_streamed_schedule_like_saved();
+	test_streamed_schedule_lines();
+	test_validate_schedule_violations();
+	if (failures > 0) {
+		printf("%d vérification(s) en échec\n", failures);
+		return EXIT_FAILURE;
+	}
+	printf("tous les tests sont passés\n");
 	return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
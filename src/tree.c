@@ -3,11 +3,18 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include "list.h"
 #include "util.h"
 
+/**
+ * @brief Les couleurs d'un nœud d'un arbre rouge-noir, stockées dans son champ bfactor.
+ */
+#define RB_BLACK 0
+#define RB_RED 1
+
 /********************************************************************
  * tree_node_t
  ********************************************************************/
@@ -15,19 +22,30 @@
 /**
  * @brief
  * Construire et initialiser un nouveau nœud d'un arbre binaire de recherche.
+ * Le nœud est pris dans la réserve \p pool de l'arbre.
+ * Si \p keySize n'est pas nul, la clé est copiée dans le nœud.
  * Le facteur d'équilibre est initialisé à zero.
  * 
+ * @param[in] pool Réserve des nœuds de l'arbre.
+ * @param[in] keySize Taille des clés stockées par valeur (0 sinon).
  * @param[in] key Clé du nouveau nœud.
  * @param[in] data Donnée à affecter au nouveau nœud.
  * @return struct tree_node_t* Le nouveau nœud créé.
  */
-static struct tree_node_t * new_tree_node(void * key, void * data) {
-	struct tree_node_t * newTreeNode = malloc(sizeof(struct tree_node_t));
+static struct tree_node_t * new_tree_node(struct pool_t * pool, size_t keySize, void * key, void * data) {
+	struct tree_node_t * newTreeNode = pool_alloc(pool);
+	if (keySize > 0) {//la clé est copiée à côté des autres champs du nœud
+		memcpy(newTreeNode->keyval, key, keySize);
+		key = newTreeNode->keyval;
+	}
 	newTreeNode->key = key;
 	newTreeNode->data = data;
 	newTreeNode->left = NULL;
 	newTreeNode->right = NULL;
+	newTreeNode->parent = NULL;
 	newTreeNode->bfactor = 0;
+	newTreeNode->size = 1;
+	newTreeNode->sum = 0;
 	return newTreeNode;
 }
 
@@ -52,6 +70,10 @@ struct tree_node_t * get_right(const struct tree_node_t * node) {
 	return node->right;
 }
 
+struct tree_node_t * get_parent(const struct tree_node_t * node) {
+	return node->parent;
+}
+
 int get_bfactor(const struct tree_node_t * node) {
 	return node->bfactor;
 }
@@ -88,11 +110,25 @@ void set_bfactor(struct tree_node_t * node, int newBFactor) {
  * tree_t
  *********************************************************************/
 
-struct tree_t * new_tree(int balanced, int (*preceed)(const void *, const void *),
+/**
+ * @brief Construire un arbre vide dont les clés font \p keySize octets si elles sont stockées par valeur (0 sinon).
+ *
+ * @param[in] balanced
+ * @param[in] keySize
+ * @param[in] preceed
+ * @param[in] viewKey
+ * @param[in] viewData
+ * @param[in] freeKey
+ * @param[in] freeData
+ * @return struct tree_t*
+ */
+static struct tree_t * make_tree(int balanced, size_t keySize, int (*preceed)(const void *, const void *),
 							void (*viewKey)(const void *), void (*viewData)(const void *),
 							void (*freeKey)(void *), void (*freeData)(void *)) {
 	struct tree_t * newTree = malloc(sizeof(struct tree_t));
 	newTree->root = NULL;
+	newTree->leftmost = NULL;
+	newTree->rightmost = NULL;
 	newTree->numelm = 0;
 	newTree->balanced = balanced;
 	newTree->preceed = preceed;
@@ -100,9 +136,26 @@ struct tree_t * new_tree(int balanced, int (*preceed)(const void *, const void *
 	newTree->viewData = viewData;
 	newTree->freeKey = freeKey;
 	newTree->freeData = freeData;
+	newTree->keySize = keySize;
+	newTree->augmented = 0;
+	newTree->weight = NULL;
+	newTree->pool = new_pool(sizeof(struct tree_node_t) + keySize);//les nœuds sont agrandis pour contenir la clé
 	return newTree;
 }
 
+struct tree_t * new_tree(int balanced, int (*preceed)(const void *, const void *),
+							void (*viewKey)(const void *), void (*viewData)(const void *),
+							void (*freeKey)(void *), void (*freeData)(void *)) {
+	return make_tree(balanced, 0, preceed, viewKey, viewData, freeKey, freeData);
+}
+
+struct tree_t * new_tree_by_value(int balanced, size_t keySize, int (*preceed)(const void *, const void *),
+							void (*viewKey)(const void *), void (*viewData)(const void *),
+							void (*freeData)(void *)) {
+	assert(keySize > 0);
+	return make_tree(balanced, keySize, preceed, viewKey, viewData, NULL, freeData);
+}
+
 int tree_is_empty(struct tree_t * T) {
 	return (T->numelm == 0);
 }
@@ -131,449 +184,805 @@ void set_root(struct tree_t * T, struct tree_node_t * newRoot) {
 	T->root = newRoot;
 }
 
+struct tree_node_t * get_tree_min_node(const struct tree_t * T) {
+	return T->leftmost;
+}
+
+struct tree_node_t * get_tree_max_node(const struct tree_t * T) {
+	return T->rightmost;
+}
+
 /**
  * @brief
- * Libérer récursivement le sous-arbre raciné au nœud curr.
- * Dans le cas où le pointeur de fonction freeKey (resp. freeData) n'est pas NULL,
- * la mémoire de la clé (resp. de la donnée) du nœud actuel est aussi libérée.
- * NB : procédure récursive.
- * 
- * @param[in] curr 
- * @param[in] freeKey 
- * @param[in] freeData 
+ * Restitue le nœud qui suit le nœud \p curr dans l'ordre infixe, NULL si \p curr est le dernier.
+ * On remonte avec les références parent : il n'y a ni récursion ni pile.
+ *
+ * @param[in] curr
+ * @return struct tree_node_t*
  */
-static void delete_tree_node(struct tree_node_t * curr, void (*freeKey)(void *), void (*freeData)(void *)) {
-	if (curr == NULL) {
-		ShowMessage("probleme avec la fontion void delete_tree_node le noeud courant est à Null", 1);
+static struct tree_node_t * next_inorder(const struct tree_node_t * curr) {
+	if (curr->right != NULL) {
+		return tree_min(curr->right);
 	}
-	delete_tree_node(curr->left, freeKey, freeData);//on supprime récursivement tous les noeuds du fils gauche de la racine donc supprimera les feuilles en premier puis remontera  
-	delete_tree_node(curr->right, freeKey, freeData);//de même pour les noeuds de droites
+	while (curr->parent != NULL && curr == curr->parent->right) {//on remonte tant qu'on vient de droite
+		curr = curr->parent;
+	}
+	return curr->parent;
+}
 
-	if (freeKey != NULL) {
-		freeKey(curr->key);// si freekey n'est pas null alors on supprime la cle du noeud courant 
+/**
+ * @brief
+ * Restitue le nœud qui précède le nœud \p curr dans l'ordre infixe, NULL si \p curr est le premier
+ * (symétrique de next_inorder).
+ *
+ * @param[in] curr
+ * @return struct tree_node_t*
+ */
+static struct tree_node_t * prev_inorder(const struct tree_node_t * curr) {
+	if (curr->left != NULL) {
+		return tree_max(curr->left);
 	}
-	if (freeData != NULL) {
-		freeData(curr->data);//cas similaire pour freedata que freekey
+	while (curr->parent != NULL && curr == curr->parent->left) {//on remonte tant qu'on vient de gauche
+		curr = curr->parent;
 	}
-	free(curr);//on libère le noeud curr
+	return curr->parent;
 }
 
-
 /**
- * NB : Utiliser la procédure récursive delete_tree_node.
- * Vous devez utiliser les bons paramètres freeKey et freeData
- * par rapport aux valeurs deleteKey et deleteData.
+ * NB : les nœuds sont parcourus dans l'ordre infixe avec next_inorder,
+ * ils sont ensuite libérés en une seule fois avec la réserve de l'arbre.
  */
 void delete_tree(struct tree_t * T, int deleteKey, int deleteData) {
 	assert(T != NULL);//on vérifie que l'arbre n'est pas vide
-	delete_tree_node(T->root,(deleteKey==1) ? T->freeKey : NULL, (deleteData==1) ? T->freeData : NULL);//on supprime l'arbre en utilisant la fonction delete_tree_node et vérifiant si on doit supprimer la cle et la donnée
+	void (*freeKey)(void *) = (deleteKey==1) ? T->freeKey : NULL;
+	void (*freeData)(void *) = (deleteData==1) ? T->freeData : NULL;
+	if ((freeKey != NULL || freeData != NULL) && T->root != NULL) {//le parcours n'est utile que pour libérer les clés ou les données
+		for (struct tree_node_t * curr = tree_min(T->root); curr != NULL; curr = next_inorder(curr)) {
+			if (freeKey != NULL) {
+				freeKey(curr->key);// si freekey n'est pas null alors on supprime la cle du noeud courant 
+			}
+			if (freeData != NULL) {
+				freeData(curr->data);//cas similaire pour freedata que freekey
+			}
+		}
+	}
+	delete_pool(T->pool);//on libère tous les noeuds d'un coup
 	free(T);//on libère l'arbre
 }
 
 /**
- * @brief
- * Afficher récursivement le sous-arbre raciné au nœud curr
- * en utilisant un ordre infixe.
- * NB : procédure récursive.
- *
- * @param[in] curr 
- * @param[in] viewKey 
- * @param[in] viewData 
+ * NB : l'ordre infixe est obtenu avec next_inorder.
  */
-static void view_tree_inorder(struct tree_node_t * curr,
-						void (*viewKey)(const void *),
-						void (*viewData)(const void *)) { 
-	if (curr != NULL) {
-		view_tree_inorder(curr->left, viewKey, viewData);//on affiche récursivement tous les noeuds du fils gauche de la racine donc affichera les feuilles en premier puis remontera
-		if (viewKey != NULL) {//si viewkey n'est pas null alors on affiche la cle du noeud courant
-			viewKey(curr->key);//on affiche la cle du noeud courant
+void view_tree(const struct tree_t * T) {
+	if (T->root == NULL) {
+		return;
+	}
+	for (struct tree_node_t * curr = tree_min(T->root); curr != NULL; curr = next_inorder(curr)) {
+		if (T->viewKey != NULL) {//si viewkey n'est pas null alors on affiche la cle du noeud courant
+			T->viewKey(curr->key);//on affiche la cle du noeud courant
 			printf("\n");//on saute une ligne pour la lisibilité
 		}
-		if (viewData != NULL) {//cas similaire pour viewdata que viewkey
-			viewData(curr->data);//on affiche la donnée du noeud courant
+		if (T->viewData != NULL) {//cas similaire pour viewdata que viewkey
+			T->viewData(curr->data);//on affiche la donnée du noeud courant
 			printf("\n");//on saute une ligne pour la lisibilité
 		}
-		view_tree_inorder(curr->right, viewKey, viewData);//de même pour les noeuds de droites
 	}
 }
 
 /**
- * NB : Utiliser la procédure récursive view_tree_inorder.
+ * @brief Restitue le poids de la clé \p key dans l'arbre augmenté \p T (0 si T n'a pas de fonction weight).
+ *
+ * @param[in] T
+ * @param[in] key
+ * @return unsigned long
  */
-void view_tree(const struct tree_t * T) {
-	view_tree_inorder(T->root, T->viewKey, T->viewData);//on affiche l'arbre en utilisant la fonction view_tree_inorder
+static unsigned long key_weight(const struct tree_t * T, const void * key) {
+	return (T->weight != NULL) ? T->weight(key) : 0;
 }
 
 /**
  * @brief
- * Effectuer une rotation gauche autour du nœud \p y.
- * N'oubliez pas à mettre à jour les facteurs d'équilibre (bfactor) des nœuds
- * modifiés. Pour ce dernier, il y a 5 cas à considérer :
- * (+) bfactor(y)=-2 et bfactor(y->right)=-1
- * (+) bfactor(y)=-2 et bfactor(y->right)=0
- * (+) bfactor(y)=-1 et bfactor(y->right)=1
- * (+) bfactor(y)=-1 et bfactor(y->right)=-1
- * (+) bfactor(y)=-1 et bfactor(y->right)=0
- * (+) bfactor(y)=-2 et bfactor(y->right)=-2
- * 
- * @param[in] y 
- * @return struct tree_node_t* 
+ * Recalculer les champs size et sum du nœud \p node de l'arbre augmenté \p T
+ * à partir de ceux de ses fils, qui doivent être à jour.
+ *
+ * @param[in] T
+ * @param[in] node
  */
-static struct tree_node_t *rotate_left(struct tree_node_t *y)
-{
-	assert(y);//on vérifie que le noeud n'est pas null
-    assert(get_right(y));//on vérifie que le fils droit du noeud n'est pas null
-
-    struct tree_node_t *x = y->right;//on récupère le fils droit du noeud courant
-    struct tree_node_t *T2 = x->left;//on récupère le fils gauche du fils droit du noeud courant
-
-    x->left = y;//on met le fils gauche du fils droit du noeud courant comme fils droit du noeud courant
-    y->right= T2;//on met le noeud courant comme fils gauche du fils droit du noeud courant
-	//en fonction du facteur d'équilibre du noeud courant et de son fils droit on met à jour les facteurs d'équilibre des noeuds modifiés
-    if((y->bfactor == -2)&&(x->bfactor == -1)){
-		y->bfactor = 0;//on met à jour le facteur d'équilibre du noeud courant
-		x->bfactor = 0;//on met à jour le facteur d'équilibre du fils droit du noeud courant
+static void update_augmentation(const struct tree_t * T, struct tree_node_t * node) {
+	node->size = 1;
+	node->sum = key_weight(T, node->key);
+	if (node->left != NULL) {
+		node->size += node->left->size;
+		node->sum += node->left->sum;
 	}
-	else if((y->bfactor == -2)&&(x->bfactor == 0)){
-		y->bfactor = -1;//on met à jour le facteur d'équilibre du noeud courant
-		x->bfactor = 1;//on met à jour le facteur d'équilibre du fils droit du noeud courant
+	if (node->right != NULL) {
+		node->size += node->right->size;
+		node->sum += node->right->sum;
 	}
-	else if((y->bfactor == -1)&&(x->bfactor == 1)){
-		y->bfactor = 0;//on met à jour le facteur d'équilibre du noeud courant
-		x->bfactor = 2;//on met à jour le facteur d'équilibre du fils droit du noeud courant
+}
+
+/**
+ * @brief
+ * Recalculer les champs size et sum des nœuds de l'arbre augmenté \p T
+ * du nœud \p node (éventuellement NULL) jusqu'à la racine.
+ *
+ * @param[in] T
+ * @param[in] node
+ */
+static void update_augmentation_path(const struct tree_t * T, struct tree_node_t * node) {
+	for (; node != NULL; node = node->parent) {
+		update_augmentation(T, node);
+	}
+}
+
+/**
+ * @brief
+ * Remplacer le fils \p oldChild du nœud \p parent par \p newChild
+ * (la racine de l'arbre \p T si \p parent vaut NULL).
+ * La référence parent de \p newChild n'est pas modifiée.
+ *
+ * @param[in] T
+ * @param[in] parent
+ * @param[in] oldChild
+ * @param[in] newChild
+ */
+static void replace_child(struct tree_t * T, struct tree_node_t * parent,
+						struct tree_node_t * oldChild, struct tree_node_t * newChild) {
+	if (parent == NULL) {
+		T->root = newChild;
+	} else if (parent->left == oldChild) {
+		parent->left = newChild;
+	} else {
+		parent->right = newChild;
 	}
-	else if((y->bfactor == -1)&&(x->bfactor == -1)){
-		y->bfactor = 1;//on met à jour le facteur d'équilibre du noeud courant
-		x->bfactor = 1;//on met à jour le facteur d'équilibre du fils droit du noeud courant
+}
+
+/**
+ * @brief
+ * Effectuer une rotation gauche autour du nœud \p x de l'arbre \p T et renvoyer la nouvelle racine
+ * du sous-arbre (l'ancien fils droit de \p x). Les références parent sont mises à jour.
+ * Si l'arbre est un arbre AVL, les facteurs d'équilibre (hauteur gauche - hauteur droite)
+ * des deux nœuds sont recalculés (les couleurs d'un arbre rouge-noir ne sont pas modifiées) :
+ * (+) bfactor(x) += 1 - min(bfactor(y), 0)
+ * (+) bfactor(y) += 1 + max(bfactor(x), 0), avec la nouvelle valeur de bfactor(x).
+ * 
+ * @param[in] T 
+ * @param[in] x 
+ * @return struct tree_node_t* 
+ */
+static struct tree_node_t * rotate_left(struct tree_t * T, struct tree_node_t * x) {
+	assert(x);//on vérifie que le noeud n'est pas null
+	assert(get_right(x));//on vérifie que le fils droit du noeud n'est pas null
+	struct tree_node_t * y = x->right;//on récupère le fils droit du noeud courant
+	x->right = y->left;//le fils gauche de y devient le fils droit de x
+	if (y->left != NULL) {
+		y->left->parent = x;
 	}
-	else if((y->bfactor == -1)&&(x->bfactor == 0)){
-		y->bfactor = 0;//on met à jour le facteur d'équilibre du noeud courant
-		x->bfactor = 1;//on met à jour le facteur d'équilibre du fils droit du noeud courant
+	y->parent = x->parent;//y prend la place de x
+	replace_child(T, x->parent, x, y);
+	y->left = x;//x devient le fils gauche de y
+	x->parent = y;
+	if (T->balanced == TREE_AVL) {
+		x->bfactor += 1 - min(y->bfactor, 0);
+		y->bfactor += 1 + max(x->bfactor, 0);
 	}
-	else if((y->bfactor == -2)&&(x->bfactor == -2)){
-		y->bfactor = 1;//on met à jour le facteur d'équilibre du noeud courant
-		x->bfactor = 0;//on met à jour le facteur d'équilibre du fils droit du noeud courant
+	if (T->augmented) {//x est maintenant le fils de y
+		update_augmentation(T, x);
+		update_augmentation(T, y);
 	}
-	return x;//on retourne le fils droit du noeud courant
+	return y;
 }
-	
 
 /**
  * @brief
- * Effectuer une rotation droite autour du nœud \p x.
- * N'oubliez pas à mettre à jour les facteurs d'équilibre (bfactor) des nœuds
- * modifiés. Pour ce dernier, il y a 5 cas à considérer :
- * (+) bfactor(x)=2 et bfactor(x->left)=1
- * (+) bfactor(x)=2 et bfactor(x->left)=0
- * (+) bfactor(x)=1 et bfactor(x->left)=1
- * (+) bfactor(x)=1 et bfactor(x->left)=-1
- * (+) bfactor(x)=1 et bfactor(x->left)=0
- * (+) bfactor(x)=2 et bfactor(x->left)=2
+ * Effectuer une rotation droite autour du nœud \p x de l'arbre \p T et renvoyer la nouvelle racine
+ * du sous-arbre (l'ancien fils gauche de \p x). Les références parent sont mises à jour.
+ * Si l'arbre est un arbre AVL, les facteurs d'équilibre des deux nœuds sont recalculés
+ * (symétrique de rotate_left) :
+ * (+) bfactor(x) -= 1 + max(bfactor(y), 0)
+ * (+) bfactor(y) -= 1 - min(bfactor(x), 0), avec la nouvelle valeur de bfactor(x).
  * 
+ * @param[in] T 
  * @param[in] x 
  * @return struct tree_node_t* 
  */
-static struct tree_node_t * rotate_right(struct tree_node_t * x) {
+static struct tree_node_t * rotate_right(struct tree_t * T, struct tree_node_t * x) {
 	assert(x);// on vérifie que le noeud n'est pas null
 	assert(get_left(x));// on vérifie que le fils gauche du noeud n'est pas null
-	// quasi similaire à la fonction rotate_left
-	struct tree_node_t *y = x->left;//on récupère le fils gauche du noeud courant
-	struct tree_node_t *T2 = y->right;//on récupère le fils droit du fils gauche du noeud courant
-	
-	y->right = x;//on met le fils droit du fils gauche du noeud courant comme fils gauche du noeud courant
-	x->left = T2;//on met le noeud courant comme fils droit du fils gauche du noeud courant
-
-	if(x->bfactor == 2 && y->bfactor == 1)
-	{
-		x->bfactor = 0;//on met à jour le facteurs d'équilibre du noeud courant
-		y->bfactor = 0;//on met à jour le facteurs d'équilibre du fils gauche du noeud courant
-	}
-	else if(x->bfactor == 2 && y->bfactor == 0)
-	{
-		x->bfactor = 1;//on met à jour le facteurs d'équilibre du noeud courant
-		y->bfactor = -1;//	on met à jour le facteurs d'équilibre du fils gauche du noeud courant
-	}
-	else if(x->bfactor == 1 && y->bfactor == 1)
-	{
-		x->bfactor = -1;//on met à jour le facteurs d'équilibre du noeud courant
-		y->bfactor = -1;//on met à jour le facteurs d'équilibre du fils gauche du noeud courant
-	}
-	else if(x->bfactor == 1 && y->bfactor == -1)
-	{
-		x->bfactor = 0;//on met à jour le facteurs d'équilibre du noeud courant
-		y->bfactor = -2;//on met à jour le facteurs d'équilibre du fils gauche du noeud courant
-	}
-	else if(x->bfactor == 1 && y->bfactor == 0)
-	{
-		x->bfactor = 0;//on met à jour le facteurs d'équilibre du noeud courant
-		y->bfactor = -1;//on met à jour le facteurs d'équilibre du fils gauche du noeud courant
-	}
-	else if(x->bfactor == 2 && y->bfactor == 2)
-	{
-		x->bfactor = -1;//on met à jour le facteurs d'équilibre du noeud courant
-		y->bfactor = 0;//on met à jour le facteurs d'équilibre du fils gauche du noeud courant
+	struct tree_node_t * y = x->left;//on récupère le fils gauche du noeud courant
+	x->left = y->right;//le fils droit de y devient le fils gauche de x
+	if (y->right != NULL) {
+		y->right->parent = x;
+	}
+	y->parent = x->parent;//y prend la place de x
+	replace_child(T, x->parent, x, y);
+	y->right = x;//x devient le fils droit de y
+	x->parent = y;
+	if (T->balanced == TREE_AVL) {
+		x->bfactor -= 1 + max(y->bfactor, 0);
+		y->bfactor -= 1 - min(x->bfactor, 0);
+	}
+	if (T->augmented) {
+		update_augmentation(T, x);
+		update_augmentation(T, y);
 	}
 	return y;
-}	
+}
 
 /**
  * @brief
- * Insérer un nouveau nœud de clé \p key et donnée \p data
- * au sous-arbre binaire de recherche raciné au nœud \p curr.
- * Les clés sont comparées en utilisant le pointeur de fonction \p preceed.
- * N'oubliez pas à mettre à jour la facteur d'équilibre du nœud \p curr.
- * N'oubliez pas à faire les rotations nécessaires (4 cas à considérer)
- * si le paramètre \p balanced indique que l'arbre est équilibré.
- * La fonction renvoie le nœud curant éventuellement mis à jour.
- * NB : fonction récursive.
- * 
- * @param[in] curr 
- * @param[in] key 
- * @param[in] data 
- * @param[in] balanced 
- * @param[in] preceed 
- * @return struct tree_node_t* 
+ * Rééquilibrer le sous-arbre raciné au nœud \p curr de l'arbre \p T, dont le facteur d'équilibre vaut 2 ou -2,
+ * avec une rotation simple ou double (4 cas), et renvoyer la nouvelle racine du sous-arbre.
+ *
+ * @param[in] T
+ * @param[in] curr
+ * @return struct tree_node_t*
  */
-static struct tree_node_t * insert_into_tree_node(struct tree_node_t * curr, void * key, void * data,
-											int balanced, int (*preceed)(const void *, const void *)) {
-	// PARTIE 1 :
-	// Mettez ici le code de l'insertion:
-	// - exception
-	// - recherche récursif de la position à insérer
-	// - mise à jour du facteur d'équilibre
-	// - insertion du nœud
-	if (tree_node_is_empty(curr)){//si le noeud courant est vide
-		return new_tree_node(key, data);//on retourne un nouveau noeud
-	}else if (preceed(key, curr->key)&&(get_left(curr)==NULL)){//si la clé est plus petite que la clé du noeud courant et que le fils gauche du noeud courant est vide
-		set_left(curr, insert_into_tree_node(get_left(curr), key, data, balanced, preceed));//on insère le noeud à gauche du noeud courant
-		decrease_bfactor(curr);//on décrémente le facteur d'équilibre du noeud courant
-	}else if (preceed(curr->key, key)&&(get_right(curr)==NULL)){//si la clé est plus grande que la clé du noeud courant et que le fils droit du noeud courant est vide
-		set_right(curr, insert_into_tree_node(get_right(curr), key, data, balanced, preceed));//on insère le noeud à droite du noeud courant
-		increase_bfactor(curr);//on incrémente le facteur d'équilibre du noeud courant
-	}else if(preceed(key, curr->key)&&(get_left(curr)!=NULL)){//si la clé est plus petite que la clé du noeud courant et que le fils gauche du noeud courant n'est pas vide
-		int bfactor = get_bfactor(get_left(curr));//on récupère le facteur d'équilibre du fils gauche du noeud courant
-		set_left(curr, insert_into_tree_node(get_left(curr), key, data, balanced, preceed));//on insère le noeud à gauche du noeud courant
-		if (bfactor < get_bfactor(get_left(curr))){//si le facteur d'équilibre du fils gauche du noeud courant est plus petit que le facteur d'équilibre du fils gauche du fils gauche du noeud courant
-			increase_bfactor(curr);//on décrémente le facteur d'équilibre du noeud courant
+static struct tree_node_t * rebalance(struct tree_t * T, struct tree_node_t * curr) {
+	if (curr->bfactor == 2) {//le fils gauche est trop haut
+		if (curr->left->bfactor < 0) {//cas gauche-droite
+			rotate_left(T, curr->left);
 		}
-	}else if(preceed(curr->key, key)&&(get_right(curr)!=NULL)){//si la clé est plus grande que la clé du noeud courant et que le fils droit du noeud courant n'est pas vide
-		int bfactor = get_bfactor(get_right(curr));//on récupère le facteur d'équilibre du fils droit du noeud courant
-		set_right(curr, insert_into_tree_node(get_right(curr), key, data, balanced, preceed));//on insère le noeud à droite du noeud courant
-		if (bfactor > get_bfactor(get_right(curr))){//si le facteur d'équilibre du fils droit du noeud courant est plus grand que le facteur d'équilibre du fils droit du fils droit du noeud courant
-			decrease_bfactor(curr);//on décrémente le facteur d'équilibre du noeud courant
+		return rotate_right(T, curr);
+	} else {//le fils droit est trop haut
+		assert(curr->bfactor == -2);
+		if (curr->right->bfactor > 0) {//cas droite-gauche
+			rotate_right(T, curr->right);
 		}
+		return rotate_left(T, curr);
 	}
-	
-	if (balanced) {
-		// PARTIE 2 :
-		// Gérer ici les rotations
-		
-		// - cas 1
-		if (get_bfactor(curr) == 2 && get_bfactor(get_left(curr)) == 1){//si le facteur d'équilibre du noeud courant est égal à 2 et que le facteur d'équilibre du fils gauche du noeud courant est égal à 1
-			curr = rotate_right(curr);//on effectue une rotation droite sur le noeud courant
-		// - cas 2
-		}else if (get_bfactor(curr) == 2 && get_bfactor(get_left(curr)) == -1){//si le facteur d'équilibre du noeud courant est égal à 2 et que le facteur d'équilibre du fils gauche du noeud courant est égal à -1
-			set_left(curr, rotate_left(get_left(curr)));//on effectue une rotation gauche sur le fils gauche du noeud courant
-			curr = rotate_right(curr);//on effectue une rotation droite sur le noeud courant
-		// - cas 3
-		}else if (get_bfactor(curr) == 2 && get_bfactor(get_left(curr)) == 0){//si le facteur d'équilibre du noeud courant est égal à 2 et que le facteur d'équilibre du fils gauche du noeud courant est égal à 0
-			curr = rotate_right(curr);//on effectue une rotation droite sur le noeud courant
-		// - cas 4
-		}else if (get_bfactor(curr) == 1 && get_bfactor(get_left(curr)) == 1){//si le facteur d'équilibre du noeud courant est égal à 1 et que le facteur d'équilibre du fils gauche du noeud courant est égal à 1
-			curr = rotate_right(curr);//on effectue une rotation droite sur le noeud courant
-		// - cas 5
-		}else if (get_bfactor(curr) == 1 && get_bfactor(get_left(curr)) == -1){
-			set_left(curr, rotate_left(get_left(curr)));//on effectue une rotation gauche sur le fils gauche du noeud courant
-			curr = rotate_right(curr);//on effectue une rotation droite sur le noeud courant
-		// - cas 6
-		}else if (get_bfactor(curr) == 1 && get_bfactor(get_left(curr)) == 0){//si le facteur d'équilibre du noeud courant est égal à 1 et que le facteur d'équilibre du fils gauche du noeud courant est égal à 0
-			curr = rotate_right(curr);//on effectue une rotation droite sur le noeud courant
-		// - cas 7
-		}else if (get_bfactor(curr) == -2 && get_bfactor(get_right(curr)) == -1){//si le facteur d'équilibre du noeud courant est égal à -2 et que le facteur d'équilibre du fils droit du noeud courant est égal à -1
-			curr = rotate_left(curr);//on effectue une rotation gauche sur le noeud courant
-		// - cas 8
-		}else if (get_bfactor(curr) == -2 && get_bfactor(get_right(curr)) == 1){//si le facteur d'équilibre du noeud courant est égal à -2 et que le facteur d'équilibre du fils droit du noeud courant est égal à 1
-			set_right(curr, rotate_right(get_right(curr)));//on effectue une rotation droite sur le fils droit du noeud courant
-			curr = rotate_left(curr);//on effectue une rotation gauche sur le noeud courant
-		// - cas 9
-		}else if (get_bfactor(curr) == -2 && get_bfactor(get_right(curr)) == 0){//si le facteur d'équilibre du noeud courant est égal à -2 et que le facteur d'équilibre du fils droit du noeud courant est égal à 0
-			curr = rotate_left(curr);//on effectue une rotation gauche sur le noeud courant
-		// - cas 10
-		}else if (get_bfactor(curr) == -1 && get_bfactor(get_right(curr)) == -1){//si le facteur d'équilibre du noeud courant est égal à -1 et que le facteur d'équilibre du fils droit du noeud courant est égal à -1
-			curr = rotate_left(curr);//on effectue une rotation gauche sur le noeud courant
-		// - cas 11
-		}else if (get_bfactor(curr) == -1 && get_bfactor(get_right(curr)) == 1){//si le facteur d'équilibre du noeud courant est égal à -1 et que le facteur d'équilibre du fils droit du noeud courant est égal à 1
-			set_right(curr, rotate_right(get_right(curr)));//on effectue une rotation droite sur le fils droit du noeud courant
-			curr = rotate_left(curr);//on effectue une rotation gauche sur le noeud courant
-		// - cas 12
-		}else if (get_bfactor(curr) == -1 && get_bfactor(get_right(curr)) == 0){//si le facteur d'équilibre du noeud courant est égal à -1 et que le facteur d'équilibre du fils droit du noeud courant est égal à 0
-			curr = rotate_left(curr);//on effectue une rotation gauche sur le noeud courant
+}
+
+/**
+ * @brief Renvoie 1 si le nœud \p node d'un arbre rouge-noir est rouge, 0 s'il est noir ou vide.
+ *
+ * @param[in] node
+ * @return int
+ */
+static int is_red(const struct tree_node_t * node) {
+	return node != NULL && node->bfactor == RB_RED;
+}
+
+/**
+ * @brief
+ * Rétablir les propriétés de l'arbre rouge-noir \p T après l'insertion du nœud rouge \p node :
+ * tant que le père de \p node est rouge, soit l'oncle est rouge et on recolore en remontant de deux niveaux,
+ * soit on termine avec une rotation simple ou double (au plus deux rotations par insertion).
+ *
+ * @param[in] T
+ * @param[in] node
+ */
+static void red_black_insert_fixup(struct tree_t * T, struct tree_node_t * node) {
+	while (is_red(node->parent)) {//le grand-père existe : la racine est noire
+		struct tree_node_t * parent = node->parent;
+		struct tree_node_t * grandParent = parent->parent;
+		int parentIsLeft = (parent == grandParent->left);
+		struct tree_node_t * uncle = parentIsLeft ? grandParent->right : grandParent->left;
+		if (is_red(uncle)) {//recoloration : le problème remonte au grand-père
+			parent->bfactor = RB_BLACK;
+			uncle->bfactor = RB_BLACK;
+			grandParent->bfactor = RB_RED;
+			node = grandParent;
+			continue;
+		}
+		if (parentIsLeft && node == parent->right) {//cas gauche-droite
+			rotate_left(T, parent);
+			parent = node;
+		} else if (!parentIsLeft && node == parent->left) {//cas droite-gauche
+			rotate_right(T, parent);
+			parent = node;
+		}
+		parent->bfactor = RB_BLACK;
+		grandParent->bfactor = RB_RED;
+		if (parentIsLeft) {
+			rotate_right(T, grandParent);
+		} else {
+			rotate_left(T, grandParent);
+		}
+		break;
+	}
+	T->root->bfactor = RB_BLACK;
+}
+
+/**
+ * @brief
+ * Rétablir les propriétés de l'arbre rouge-noir \p T après la suppression d'un nœud noir :
+ * le sous-arbre gauche (si \p fromLeft vaut 1) ou droit du nœud \p parent, de racine \p child
+ * (éventuellement vide), a un nœud noir de moins que son frère sur chacun de ses chemins.
+ * On recolore en remontant tant que le frère et ses fils sont noirs,
+ * sinon on termine avec au plus trois rotations.
+ *
+ * @param[in] T
+ * @param[in] child
+ * @param[in] parent
+ * @param[in] fromLeft
+ */
+static void red_black_remove_fixup(struct tree_t * T, struct tree_node_t * child,
+								struct tree_node_t * parent, int fromLeft) {
+	while (parent != NULL && !is_red(child)) {
+		struct tree_node_t * sibling = fromLeft ? parent->right : parent->left;//non vide : il porte un nœud noir de plus
+		if (is_red(sibling)) {//on se ramène à un frère noir
+			sibling->bfactor = RB_BLACK;
+			parent->bfactor = RB_RED;
+			if (fromLeft) {
+				rotate_left(T, parent);
+				sibling = parent->right;
+			} else {
+				rotate_right(T, parent);
+				sibling = parent->left;
+			}
+		}
+		if (!is_red(sibling->left) && !is_red(sibling->right)) {//recoloration : le problème remonte au père
+			sibling->bfactor = RB_RED;
+			child = parent;
+			parent = parent->parent;
+			fromLeft = (parent != NULL && parent->left == child);
+			continue;
+		}
+		if (fromLeft) {
+			if (!is_red(sibling->right)) {//cas droite-gauche
+				sibling->left->bfactor = RB_BLACK;
+				sibling->bfactor = RB_RED;
+				sibling = rotate_right(T, sibling);
+			}
+			sibling->bfactor = parent->bfactor;
+			parent->bfactor = RB_BLACK;
+			sibling->right->bfactor = RB_BLACK;
+			rotate_left(T, parent);
+		} else {
+			if (!is_red(sibling->left)) {//cas gauche-droite
+				sibling->right->bfactor = RB_BLACK;
+				sibling->bfactor = RB_RED;
+				sibling = rotate_left(T, sibling);
+			}
+			sibling->bfactor = parent->bfactor;
+			parent->bfactor = RB_BLACK;
+			sibling->left->bfactor = RB_BLACK;
+			rotate_right(T, parent);
 		}
+		return;
+	}
+	if (child != NULL) {
+		child->bfactor = RB_BLACK;
 	}
-	return curr;//on retourne le noeud courant
 }
 
 /**
- * NB : Utiliser la fonction récursive insert_into_tree_node.
+ * NB : la position est cherchée sans récursion ; une clé égale à une clé existante
+ * est placée après celle-ci (à droite), l'ordre d'insertion des clés égales est donc conservé.
+ * Si l'arbre est un arbre AVL, les facteurs d'équilibre sont mis à jour en remontant
+ * avec les références parent, jusqu'au premier nœud dont la hauteur ne change pas
+ * (au plus une rotation simple ou double).
+ * Si l'arbre est un arbre rouge-noir, le nouveau nœud est rouge et red_black_insert_fixup
+ * rétablit les couleurs (au plus deux rotations).
  */
-void tree_insert(struct tree_t * T, void * key, void * data) {
+struct tree_node_t * tree_insert(struct tree_t * T, void * key, void * data) {
 	assert(T != NULL);//on vérifie que l'arbre n'est pas vide
 	assert(key != NULL);//on vérifie que la clé n'est pas vide
 	assert(data != NULL);//on vérifie que les données n'est pas vide
-  set_root(T,insert_into_tree_node(T->root, key, data, T->balanced, T->preceed));//on insère le noeud dans l'arbre
-  increase_tree_size(T);//on incrémente la taille de l'arbre
+	struct tree_node_t * parent = NULL;
+	struct tree_node_t * curr = T->root;
+	int left = 0;
+	while (curr != NULL) {//recherche de la position à insérer
+		parent = curr;
+		left = T->preceed(key, curr->key);
+		curr = left ? curr->left : curr->right;
+	}
+	struct tree_node_t * node = new_tree_node(T->pool, T->keySize, key, data);
+	node->parent = parent;
+	if (parent == NULL) {
+		T->root = node;
+		T->leftmost = node;
+		T->rightmost = node;
+	} else if (left) {
+		parent->left = node;
+		if (parent == T->leftmost) {//le nouveau nœud est le nouveau minimum
+			T->leftmost = node;
+		}
+	} else {
+		parent->right = node;
+		if (parent == T->rightmost) {//le nouveau nœud est le nouveau maximum
+			T->rightmost = node;
+		}
+	}
+	increase_tree_size(T);//on incrémente la taille de l'arbre
+	if (T->augmented) {//avant les rotations, qui recalculent leurs nœuds à partir des fils
+		update_augmentation_path(T, node);
+	}
+	if (T->balanced == TREE_BST) {
+		return node;
+	}
+	if (T->balanced == TREE_RED_BLACK) {
+		node->bfactor = RB_RED;
+		red_black_insert_fixup(T, node);
+		return node;
+	}
+	for (curr = node, parent = node->parent; parent != NULL; curr = parent, parent = parent->parent) {
+		if (curr == parent->left) {//la hauteur du sous-arbre curr a augmenté de 1
+			increase_bfactor(parent);
+		} else {
+			decrease_bfactor(parent);
+		}
+		if (parent->bfactor == 0) {//la hauteur de parent n'a pas changé
+			break;
+		}
+		if (parent->bfactor == 2 || parent->bfactor == -2) {//après la rotation, parent retrouve sa hauteur d'avant l'insertion
+			rebalance(T, parent);
+			break;
+		}
+	}
+	return node;
 }
 
 struct tree_node_t * tree_min(struct tree_node_t * curr) {
 	assert(!tree_node_is_empty(curr));//on vérifie que le noeud courant n'est pas vide
-	if(curr->left != NULL){//si le fils gauche du noeud courant n'est pas vide
-		return tree_min(curr->left);//on appelle la fonction récursive tree_min sur le fils gauche du noeud courant
-	}else{
-		return curr;//on retourne le noeud courant
+	while (curr->left != NULL) {//on descend à gauche
+		curr = curr->left;
 	}
+	return curr;
 }
 
 struct tree_node_t * tree_max(struct tree_node_t * curr) {
 	// similaire à tree_min
 	assert(!tree_node_is_empty(curr));//on vérifie que le noeud courant n'est pas vide
-	if(curr->right != NULL){//si le fils droit du noeud courant n'est pas vide
-		return tree_max(curr->right);//on appelle la fonction récursive tree_max sur le fils droit du noeud courant
-	}else{
-		return curr;//on retourne le noeud courant
+	while (curr->right != NULL) {//on descend à droite
+		curr = curr->right;
 	}
+	return curr;
 }
 
 struct tree_node_t * tree_find_node(struct tree_node_t * curr, void * key, int (*preceed)(const void *, const void *)) {
-	assert(!tree_node_is_empty(curr));//on vérifie que le noeud courant n'est pas vide
-	if (preceed(key, curr->key)){//si la clé est inférieure à la clé du noeud courant
-		return tree_find_node(get_left(curr), key, preceed);//on appelle la fonction récursive tree_find_node sur le fils gauche du noeud courant
-	}else if (preceed(curr->key, key)){//si la clé est supérieure à la clé du noeud courant
-		return tree_find_node(get_right(curr), key, preceed);//on appelle la fonction récursive tree_find_node sur le fils droit du noeud courant
-	}else{
-		return curr;//on retourne le noeud courant
+	struct tree_node_t * found = NULL;
+	while (curr != NULL) {
+		if (preceed(curr->key, key)) {//la clé est supérieure à la clé du noeud courant
+			curr = curr->right;
+		} else {//la clé est inférieure ou égale : on continue à gauche pour trouver la première clé égale
+			if (!preceed(key, curr->key)) {
+				found = curr;
+			}
+			curr = curr->left;
+		}
 	}
+	return found;
 }
 
 struct tree_node_t * tree_find_predecessor(struct tree_node_t * curr, void * key, int (*preceed)(const void *, const void *)) {
-	assert(!tree_node_is_empty(curr));//on vérifie que le noeud courant n'est pas vide
-	if (preceed(key, curr->key)){//si la clé est inférieure à la clé du noeud courant
-		return tree_find_predecessor(get_left(curr), key, preceed);//on appelle la fonction récursive tree_find_predecessor sur le fils gauche du noeud courant
-	}else if (preceed(curr->key, key)){//si la clé est supérieure à la clé du noeud courant
-		struct tree_node_t * tmp = tree_find_predecessor(get_right(curr), key, preceed);//on appelle la fonction récursive tree_find_predecessor sur le fils droit du noeud courant
-		if (tree_node_is_empty(tmp)){//si le noeud retourné par la fonction récursive est vide
-			return curr;//on retourne le noeud courant
-		}else{
-			return tmp;//on retourne le noeud retourné par la fonction récursive
+	struct tree_node_t * pred = NULL;
+	while (curr != NULL) {
+		if (preceed(curr->key, key)) {//la clé du noeud courant est plus petite : candidat, on cherche plus grand à droite
+			pred = curr;
+			curr = curr->right;
+		} else {
+			curr = curr->left;
 		}
-	}else{
-		return tree_max(get_left(curr));//on retourne le noeud maximum du fils gauche du noeud courant
 	}
+	return pred;
 }
 
 struct tree_node_t * tree_find_successor(struct tree_node_t * curr, void * key, int (*preceed)(const void *, const void *)) {
 	// similaire à tree_find_predecessor
-	assert(!tree_node_is_empty(curr));//on vérifie que le noeud courant n'est pas vide
-	if (preceed(key, curr->key)){//si la clé est inférieure à la clé du noeud courant
-		struct tree_node_t * tmp = tree_find_successor(get_left(curr), key, preceed);//on appelle la fonction récursive tree_find_successor sur le fils gauche du noeud courant
-		if (tree_node_is_empty(tmp)){//si le noeud retourné par la fonction récursive est vide
-			return curr;//on retourne le noeud courant
-		}else{
-			return tmp;//on retourne le noeud retourné par la fonction récursive
+	struct tree_node_t * succ = NULL;
+	while (curr != NULL) {
+		if (preceed(key, curr->key)) {//la clé du noeud courant est plus grande : candidat, on cherche plus petit à gauche
+			succ = curr;
+			curr = curr->left;
+		} else {
+			curr = curr->right;
 		}
-	}else if (preceed(curr->key, key)){//si la clé est supérieure à la clé du noeud courant
-		return tree_find_successor(get_right(curr), key, preceed);//on appelle la fonction récursive tree_find_successor sur le fils droit du noeud courant
-	}else{//si la clé est égale à la clé du noeud courant
-		return tree_min(get_right(curr));//on retourne le noeud minimum du fils droit du noeud courant
 	}
+	return succ;
 }
 
 /**
  * @brief 
- * Supprimer le nœud de clé \p key du sous-arbre binaire de recherche raciné au nœud \p curr.
- * La donnée du nœud supprimé est restituée en utilisant le pointeur \p data (passage de paramètre par référence).
- * Les clés sont comparées en utilisant le pointeur de fonction \p preceed.
- * N'oubliez pas à mettre à jour la facteur d'équilibre du nœud \p curr.
- * N'oubliez pas à faire les rotations nécessaires (6 cas à considérer)
- * si le paramètre \p balanced indique que l'arbre est équilibré.
- * La fonction renvoie le nœud curant éventuellement mis à jour.
- * NB : fonction récursive.
+ * Détacher le nœud \p node de l'arbre \p T sans libérer sa mémoire.
+ * Les références leftmost et rightmost de l'arbre sont mises à jour
+ * (les rotations ne changent pas l'ordre infixe, elles n'ont pas à le faire).
+ * Si \p node a deux fils, c'est son successeur qui prend sa place dans l'arbre :
+ * les nœuds ne sont jamais recopiés, un nœud reste donc associé à sa clé et à sa donnée.
+ * Si l'arbre est un arbre AVL, les facteurs d'équilibre sont mis à jour en remontant
+ * depuis le nœud dont un sous-arbre a perdu un niveau, avec les rotations nécessaires,
+ * jusqu'au premier nœud dont la hauteur ne change pas.
+ * Si l'arbre est un arbre rouge-noir et que la position libérée était noire,
+ * red_black_remove_fixup rétablit les couleurs.
  * 
- * @param[in] curr 
- * @param[in] key 
- * @param[out] data 
- * @param[in] balanced 
- * @param[in] preceed 
- * @return struct tree_node_t* 
+ * @param[in] T 
+ * @param[in] node 
  */
-static struct tree_node_t * remove_tree_node(struct tree_node_t * curr, void * key, void ** data, int balanced, 
-											int (*preceed)(const void *, const void *)) {
-	assert(curr);
-	// PARTIE 1 :
-	// Mettez ici le code de la suppression:	
-	// - exception
-	// - recherche récursif de la clé à supprimer
-	// - mise à jour du facteur d'équilibre
-	// - suppression du nœud
-	*data = NULL;//on met NULL dans la variable data
-	if(tree_node_is_empty(curr)){//si le noeud courant est vide
-		data = get_tree_node_data(curr);//on met la donnée du noeud courant dans la variable data
-		free(curr);//on libère le noeud courant
-		return NULL;//on retourne NULL
-	}else if(preceed(key, curr->key)){//si la clé est inférieure à la clé du noeud courant
-		set_left(curr, remove_tree_node(get_left(curr), key, data, balanced, preceed));
-	}else if(preceed(curr->key, key)){//si la clé est supérieure à la clé du noeud courant
-		set_right(curr, remove_tree_node(get_right(curr), key, data, balanced, preceed));
-	}else{//si la clé est égale à la clé du noeud courant
-		*data = curr->data;//on met la donnée du noeud courant dans la variable data
-		if(get_left(curr) == NULL){//si le fils gauche du noeud courant est vide
-			struct tree_node_t * tmp = get_right(curr);//on met le fils droit du noeud courant dans une variable temporaire
-			free(curr);//on libère le noeud courant
-			return tmp;//on retourne la variable temporaire
-		}else if(get_right(curr) == NULL){//si le fils droit du noeud courant est vide
-			struct tree_node_t * tmp = get_left(curr);//on met le fils gauche du noeud courant dans une variable temporaire
-			free(curr);//on libère le noeud courant
-			return tmp;//on retourne la variable temporaire
-		}else{//si les deux fils du noeud courant ne sont pas vides
-			struct tree_node_t * tmp = tree_min(get_right(curr));//on met le noeud minimum du fils droit du noeud courant dans une variable temporaire
-			curr->key = tmp->key;//on met la clé du noeud temporaire dans la clé du noeud courant
-			curr->data = tmp->data;//on met la donnée du noeud temporaire dans la donnée du noeud courant
-			set_right(curr, remove_tree_node(get_right(curr), tmp->key, data, balanced, preceed));//on appelle la fonction récursive remove_tree_node sur le fils droit du noeud courant
-		}
+static void unlink_tree_node(struct tree_t * T, struct tree_node_t * node) {
+	struct tree_node_t * parent;//nœud dont un sous-arbre a perdu un niveau
+	int fromLeft;//1 si c'est son sous-arbre gauche
+	struct tree_node_t * child;//nouvelle racine de ce sous-arbre
+	int removedColor;//couleur de la position libérée (arbre rouge-noir)
+	if (node == T->leftmost) {
+		T->leftmost = next_inorder(node);
 	}
-
-	if (balanced && curr) {
-		// PARTIE 2 :
-		// Gérer ici les rotations
-		if ((curr->bfactor == 2)) {//si le facteur d'équilibre du noeud courant est égal à 2
-			if (curr->left->bfactor == 1){//si le facteur d'équilibre du fils gauche du noeud courant est égal à 1
-				curr = rotate_right(curr);//on fait une rotation droite
-			}else if (curr->left->bfactor == -1) {//si le facteur d'équilibre du fils gauche du noeud courant est égal à -1
-				//rotation gauche droite
-				curr->left = rotate_left(curr->left);//on fait une rotation gauche sur le fils gauche du noeud courant
-				curr = rotate_right(curr);//on fait une rotation droite sur le noeud courant
-			}else{//si le facteur d'équilibre du fils gauche du noeud courant est égal à 0
-				curr = rotate_right(curr);//on fait une rotation droite
+	if (node == T->rightmost) {
+		T->rightmost = prev_inorder(node);
+	}
+	if (node->left != NULL && node->right != NULL) {//le successeur (sans fils gauche) prend la place de node
+		struct tree_node_t * succ = tree_min(node->right);
+		child = succ->right;
+		removedColor = succ->bfactor;
+		if (succ->parent != node) {
+			parent = succ->parent;
+			fromLeft = 1;
+			parent->left = succ->right;//le fils droit du successeur prend sa place
+			if (succ->right != NULL) {
+				succ->right->parent = parent;
 			}
-		}else if (curr->bfactor == -2) {//si le facteur d'équilibre du noeud courant est égal à -2
-			if (curr->right->bfactor == -1) {//si le facteur d'équilibre du fils droit du noeud courant est égal à -1
-				curr = rotate_left(curr);//on fait une rotation gauche
-			}else if (curr->right->bfactor == 1){//si le facteur d'équilibre du fils droit du noeud courant est égal à 1
-				curr->right = rotate_right(curr->right);//on fait une rotation droite sur le fils droit du noeud courant
-				curr = rotate_left(curr);//on fait une rotation gauche sur le noeud courant
-			}else{//si le facteur d'équilibre du fils droit du noeud courant est égal à 0
-				curr = rotate_left(curr);//on fait une rotation gauche
+			succ->right = node->right;
+			node->right->parent = succ;
+		} else {//le successeur est le fils droit de node : il garde son fils droit
+			parent = succ;
+			fromLeft = 0;
+		}
+		succ->left = node->left;
+		node->left->parent = succ;
+		succ->parent = node->parent;
+		replace_child(T, node->parent, node, succ);
+		succ->bfactor = node->bfactor;
+	} else {//node a au plus un fils, qui prend sa place
+		child = (node->left != NULL) ? node->left : node->right;
+		removedColor = node->bfactor;
+		parent = node->parent;
+		fromLeft = (parent != NULL && parent->left == node);
+		if (child != NULL) {
+			child->parent = parent;
+		}
+		replace_child(T, parent, node, child);
+	}
+	if (T->augmented) {//parent est le nœud le plus bas dont le sous-arbre a changé
+		update_augmentation_path(T, parent);
+	}
+	if (T->balanced == TREE_BST) {
+		return;
+	}
+	if (T->balanced == TREE_RED_BLACK) {
+		if (removedColor == RB_BLACK) {
+			red_black_remove_fixup(T, child, parent, fromLeft);
+		}
+		return;
+	}
+	while (parent != NULL) {
+		if (fromLeft) {
+			decrease_bfactor(parent);
+		} else {
+			increase_bfactor(parent);
+		}
+		if (parent->bfactor == 1 || parent->bfactor == -1) {//la hauteur de parent n'a pas changé
+			break;
+		}
+		if (parent->bfactor == 2 || parent->bfactor == -2) {
+			int sibling = (parent->bfactor == 2) ? parent->left->bfactor : parent->right->bfactor;
+			parent = rebalance(T, parent);
+			if (sibling == 0) {//rotation simple sur un frère équilibré : la hauteur ne change pas
+				break;
 			}
 		}
+		//la hauteur du sous-arbre parent a diminué de 1 : on remonte
+		struct tree_node_t * up = parent->parent;
+		fromLeft = (up != NULL && up->left == parent);
+		parent = up;
 	}
-	return curr;//on retourne le noeud courant
 }
 
 /**
- * NB : Utiliser la fonction récursive remove_tree_node.
+ * NB : le nœud est cherché avec tree_find_node (le premier nœud de clé égale dans l'ordre infixe)
+ * puis supprimé avec tree_remove_node.
  */
 void * tree_remove(struct tree_t * T, void * key) {
-    void * data = NULL;//on met NULL dans la variable data
-    T->root = remove_tree_node(T->root, key, &data, T->balanced, T->preceed);//on appelle la fonction récursive remove_tree_node sur la racine de l'arbre
-	decrease_tree_size(T);//on décrémente la taille de l'arbre
-	return data;//on retourne la variable data
+	struct tree_node_t * node = tree_find_node(T->root, key, T->preceed);
+	assert(node != NULL);//la clé existe obligatoirement dans l'arbre
+	return tree_remove_node(T, node);
+}
+
+void * tree_remove_node(struct tree_t * T, struct tree_node_t * node) {
+	assert(T != NULL && node != NULL);
+	void * data = node->data;
+	unlink_tree_node(T, node);
+	pool_free(T->pool, node);//on rend le noeud à la réserve
+	decrease_tree_size(T);
+	return data;
+}
+
+/**
+ * NB : le minimum est le nœud leftmost, détaché avec unlink_tree_node sans nouvelle recherche.
+ */
+void * tree_pop_min(struct tree_t * T, void ** key) {
+	assert(!tree_is_empty(T));
+	struct tree_node_t * node = T->leftmost;
+	void * data = node->data;
+	void * nodeKey = (T->keySize > 0) ? NULL : node->key;//une clé stockée par valeur disparaît avec le nœud
+	unlink_tree_node(T, node);
+	pool_free(T->pool, node);//on rend le noeud à la réserve
+	decrease_tree_size(T);
+	if (key != NULL) {
+		*key = nodeKey;
+	} else if (nodeKey != NULL && T->freeKey != NULL) {
+		T->freeKey(nodeKey);
+	}
+	return data;
+}
+
+struct tree_node_t * tree_iter_begin(const struct tree_t * T) {
+	return T->leftmost;
+}
+
+/**
+ * NB : descente itérative, comme tree_find_node, en retenant le dernier nœud de clé supérieure ou égale.
+ */
+struct tree_node_t * tree_iter_begin_at(const struct tree_t * T, const void * key) {
+	struct tree_node_t * first = NULL;
+	struct tree_node_t * curr = T->root;
+	while (curr != NULL) {
+		if (T->preceed(curr->key, key)) {//la clé du nœud courant est plus petite : on cherche à droite
+			curr = curr->right;
+		} else {//candidat, on cherche plus petit à gauche
+			first = curr;
+			curr = curr->left;
+		}
+	}
+	return first;
+}
+
+struct tree_node_t * tree_iter_next(const struct tree_node_t * node) {
+	return next_inorder(node);
+}
+
+int tree_range(const struct tree_t * T, const void * lo, const void * hi,
+				int (*callback)(void * key, void * data, void * arg), void * arg) {
+	int count = 0;
+	struct tree_node_t * curr = (lo != NULL) ? tree_iter_begin_at(T, lo) : T->leftmost;
+	while (curr != NULL && (hi == NULL || !T->preceed(hi, curr->key))) {//on s'arrête à la première clé supérieure à hi
+		count++;
+		if (!callback(curr->key, curr->data, arg)) {
+			break;
+		}
+		curr = next_inorder(curr);
+	}
+	return count;
+}
+
+int tree_keys_are_sorted(void ** keys, int n, int (*preceed)(const void *, const void *)) {
+	for (int i = 1; i < n; i++) {
+		if (preceed(keys[i], keys[i - 1])) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/**
+ * @brief Restitue la hauteur d'un arbre parfaitement équilibré de \p n nœuds construit par tree_build_from_sorted.
+ *
+ * @param[in] n
+ * @return int
+ */
+static int sorted_height(int n) {
+	int h = 0;
+	while (n > 0) {//n nœuds : la racine plus deux sous-arbres d'au plus n/2 nœuds
+		n /= 2;
+		h++;
+	}
+	return h;
+}
+
+/**
+ * @brief
+ * Construire le sous-arbre des éléments d'indice lo, ..., hi-1 des tableaux \p keys et \p data
+ * (déjà triés) : la racine est l'élément du milieu, le sous-arbre gauche a autant ou un nœud
+ * de plus que le sous-arbre droit. Le facteur d'équilibre de chaque nœud est calculé directement
+ * à partir de la taille de ses sous-arbres ; dans un arbre rouge-noir, seuls les nœuds situés
+ * \p redDepth niveaux sous ce sous-arbre sont rouges (aucun si \p redDepth est négatif).
+ * NB : fonction récursive, de profondeur log2(n).
+ *
+ * @param[in] T
+ * @param[in] keys
+ * @param[in] data
+ * @param[in] lo
+ * @param[in] hi
+ * @param[in] parent
+ * @param[in] redDepth
+ * @return struct tree_node_t*
+ */
+static struct tree_node_t * build_tree_node(struct tree_t * T, void ** keys, void ** data, int lo, int hi,
+											struct tree_node_t * parent, int redDepth) {
+	if (lo >= hi) {
+		return NULL;
+	}
+	int mid = lo + (hi - lo) / 2;
+	struct tree_node_t * node = new_tree_node(T->pool, T->keySize, keys[mid], data[mid]);
+	node->parent = parent;
+	node->left = build_tree_node(T, keys, data, lo, mid, node, redDepth - 1);
+	node->right = build_tree_node(T, keys, data, mid + 1, hi, node, redDepth - 1);
+	if (T->balanced == TREE_RED_BLACK) {
+		node->bfactor = (redDepth == 0) ? RB_RED : RB_BLACK;
+	} else {
+		node->bfactor = sorted_height(mid - lo) - sorted_height(hi - mid - 1);
+	}
+	if (T->augmented) {
+		update_augmentation(T, node);
+	}
+	return node;
+}
+
+/**
+ * NB : l'arbre est construit avec build_tree_node, chaque élément est visité une fois.
+ */
+void tree_build_from_sorted(struct tree_t * T, void ** keys, void ** data, int n) {
+	assert(T != NULL);
+	assert(tree_is_empty(T));//l'arbre doit être vide
+	assert(tree_keys_are_sorted(keys, n, T->preceed));
+	if (n == 0) {
+		return;
+	}
+	int h = sorted_height(n);
+	//le dernier niveau est rouge s'il est incomplet : tous les chemins ont alors h-1 nœuds noirs
+	int redDepth = (n == (1 << h) - 1) ? -1 : h - 1;
+	T->root = build_tree_node(T, keys, data, 0, n, NULL, redDepth);
+	T->leftmost = tree_min(T->root);
+	T->rightmost = tree_max(T->root);
+	T->numelm = n;
+}
+
+void tree_augment(struct tree_t * T, unsigned long (*weight)(const void *)) {
+	assert(tree_is_empty(T));//les nœuds existants n'auraient pas leurs champs à jour
+	T->augmented = 1;
+	T->weight = weight;
+}
+
+/**
+ * NB : on descend à gauche si le sous-arbre gauche contient plus de k nœuds, sinon à droite en retirant
+ * du rang les nœuds laissés à gauche.
+ */
+struct tree_node_t * tree_select(const struct tree_t * T, int k) {
+	assert(T->augmented);
+	assert(0 <= k && k < get_tree_size(T));
+	struct tree_node_t * curr = T->root;
+	while (curr != NULL) {
+		int leftSize = (curr->left != NULL) ? curr->left->size : 0;
+		if (k < leftSize) {
+			curr = curr->left;
+		} else if (k == leftSize) {
+			return curr;
+		} else {
+			k -= leftSize + 1;
+			curr = curr->right;
+		}
+	}
+	return NULL;
+}
+
+int tree_rank(const struct tree_t * T, const void * key) {
+	assert(T->augmented);
+	int rank = 0;
+	struct tree_node_t * curr = T->root;
+	while (curr != NULL) {
+		if (T->preceed(curr->key, key)) {//curr et son sous-arbre gauche précèdent key
+			rank += 1 + ((curr->left != NULL) ? curr->left->size : 0);
+			curr = curr->right;
+		} else {
+			curr = curr->left;
+		}
+	}
+	return rank;
+}
+
+unsigned long tree_prefix_sum(const struct tree_t * T, int k) {
+	assert(T->augmented);
+	assert(0 <= k && k <= get_tree_size(T));
+	unsigned long sum = 0;
+	struct tree_node_t * curr = T->root;
+	while (curr != NULL && k > 0) {
+		int leftSize = (curr->left != NULL) ? curr->left->size : 0;
+		if (k <= leftSize) {
+			curr = curr->left;
+		} else {//le sous-arbre gauche et curr font partie des k premiers
+			sum += ((curr->left != NULL) ? curr->left->sum : 0) + key_weight(T, curr->key);
+			k -= leftSize + 1;
+			curr = curr->right;
+		}
+	}
+	return sum;
 }
@@ -0,0 +1,353 @@
+#include "validator.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "util.h"
+#include "list.h"
+#include "instance.h"
+#include "schedule.h"
+
+/********************************************************************
+ * Index des tâches de l'instance
+ ********************************************************************/
+
+static int compare_task_ids(const void * a, const void * b) {
+	return strcmp(get_task_id(*(struct task_t * const *) a), get_task_id(*(struct task_t * const *) b));
+}
+
+/**
+ * @brief Restituer le tableau des tâches de l'instance \p I trié par identifiant,
+ * et écrire sa taille dans \p num_tasks.
+ *
+ * @param[in] I
+ * @param[out] num_tasks
+ * @return struct task_t**
+ */
+static struct task_t ** new_task_index(Instance I, int * num_tasks) {
+	int n = get_list_size(I);
+	struct task_t ** tasks = (struct task_t **) malloc((n + 1) * sizeof(struct task_t *));
+	if (tasks == NULL) {
+		ShowMessage("src.validator.c:new_task_index : allocation impossible", 1);
+	}
+	int i = 0;
+	for (struct list_node_t * node = get_list_head(I); node != NULL; node = get_successor(node)) {
+		tasks[i++] = get_list_node_data(node);
+	}
+	qsort(tasks, n, sizeof(struct task_t *), compare_task_ids);
+	*num_tasks = n;
+	return tasks;
+}
+
+/**
+ * @brief Restituer la position dans l'index \p tasks de la tâche d'identifiant \p id, -1 si elle n'y est pas.
+ *
+ * @param[in] tasks
+ * @param[in] num_tasks
+ * @param[in] id
+ * @return int
+ */
+static int find_task_index(struct task_t ** tasks, int num_tasks, const char * id) {
+	int lo = 0, hi = num_tasks - 1;
+	while (lo <= hi) {
+		int mid = lo + (hi - lo) / 2;
+		int cmp = strcmp(id, get_task_id(tasks[mid]));
+		if (cmp == 0) {
+			return mid;
+		}
+		if (cmp < 0) {
+			hi = mid - 1;
+		} else {
+			lo = mid + 1;
+		}
+	}
+	return -1;
+}
+
+/********************************************************************
+ * Vérification
+ ********************************************************************/
+
+/**
+ * @brief
+ * L'état partagé par les fils d'exécution de validate_schedule :
+ * (+) l'ordonnancement (S) et l'index des tâches de l'instance (tasks, num_tasks),
+ * (+) la durée ordonnancée de chaque tâche de l'index (done), cumulée par ajouts atomiques,
+ * (+) pour chaque machine, l'indice dans l'index de la tâche de chaque segment (indices, -1 si inconnue),
+ *     l'ordre des segments par date de début (orders, NULL s'ils sont déjà dans cet ordre) et
+ *     le rang dans cet ordre de la première violation trouvée (firsts, INT_MAX s'il n'y en a pas),
+ * (+) le tableau des violations à remplir (violations),
+ * (+) la prochaine machine à traiter (next_machine), et
+ * (+) la passe en cours (pass) : 0 pour les contrôles des segments, 1 pour celui des durées des tâches.
+ */
+struct validation_t {
+	const struct schedule_t * S;
+	struct task_t ** tasks;
+	int num_tasks;
+	unsigned long * done;
+	int ** indices;
+	int ** orders;
+	int * firsts;
+	struct schedule_violation_t * violations;
+	int next_machine;
+	int pass;
+};
+
+/**
+ * @brief
+ * Un segment à trier : sa date de début (begin_time) et son indice (segment) dans la machine.
+ */
+struct segment_ref_t {
+	unsigned long begin_time;
+	int segment;
+};
+
+static int compare_segment_refs(const void * a, const void * b) {
+	const struct segment_ref_t * x = a;
+	const struct segment_ref_t * y = b;
+	if (x->begin_time != y->begin_time) {
+		return (x->begin_time > y->begin_time) - (x->begin_time < y->begin_time);
+	}
+	return (x->segment > y->segment) - (x->segment < y->segment);
+}
+
+/**
+ * @brief Restituer l'ordre des segments de \p MS par date de début, ou NULL s'ils sont déjà dans cet ordre.
+ *
+ * @param[in] MS
+ * @return int*
+ */
+static int * sort_segments(const struct machine_schedule_t * MS) {
+	int sorted = 1;
+	for (int j = 1; j < MS->size && sorted; j++) {
+		sorted = MS->begin_times[j - 1] <= MS->begin_times[j];
+	}
+	if (sorted) {
+		return NULL;
+	}
+	struct segment_ref_t * refs = (struct segment_ref_t *) malloc(MS->size * sizeof(struct segment_ref_t));
+	int * order = (int *) malloc(MS->size * sizeof(int));
+	if (refs == NULL || order == NULL) {
+		ShowMessage("src.validator.c:sort_segments : allocation impossible", 1);
+	}
+	for (int j = 0; j < MS->size; j++) {
+		refs[j] = (struct segment_ref_t) { MS->begin_times[j], j };
+	}
+	qsort(refs, MS->size, sizeof(struct segment_ref_t), compare_segment_refs);
+	for (int j = 0; j < MS->size; j++) {
+		order[j] = refs[j].segment;
+	}
+	free(refs);
+	return order;
+}
+
+/**
+ * @brief Noter la violation \p type au segment \p segment (de rang \p rank) de la machine \p m,
+ * si aucune violation de rang inférieur n'a déjà été trouvée.
+ */
+static void record_violation(struct validation_t * V, int m, int rank, int segment, int type) {
+	if (rank < V->firsts[m]) {
+		const struct machine_schedule_t * MS = get_schedule_of_machine(V->S, m);
+		V->firsts[m] = rank;
+		V->violations[m] = (struct schedule_violation_t) { type, segment, MS->tasks[segment] };
+	}
+}
+
+/**
+ * @brief Première passe sur la machine \p m : identifier les tâches, contrôler chaque segment
+ * et le chevauchement avec le segment précédent, et cumuler les durées des tâches.
+ */
+static void check_machine_segments(struct validation_t * V, int m) {
+	const struct machine_schedule_t * MS = get_schedule_of_machine(V->S, m);
+	int * indices = (int *) malloc((MS->size + 1) * sizeof(int));
+	if (indices == NULL) {
+		ShowMessage("src.validator.c:check_machine_segments : allocation impossible", 1);
+	}
+	V->indices[m] = indices;
+	V->orders[m] = sort_segments(MS);
+	unsigned long last = 0;
+	for (int r = 0; r < MS->size; r++) {
+		int j = V->orders[m] != NULL ? V->orders[m][r] : r;
+		unsigned long bt = MS->begin_times[j], et = MS->end_times[j];
+		int t = find_task_index(V->tasks, V->num_tasks, get_task_id(MS->tasks[j]));
+		indices[j] = t;
+		if (t < 0) {
+			record_violation(V, m, r, j, VIOLATION_UNKNOWN_TASK);
+		} else if (et <= bt) {
+			record_violation(V, m, r, j, VIOLATION_EMPTY);
+		} else if (bt < get_task_release_time(V->tasks[t])) {
+			record_violation(V, m, r, j, VIOLATION_RELEASE);
+		} else if (r > 0 && bt < last) {
+			record_violation(V, m, r, j, VIOLATION_OVERLAP);
+		}
+		if (t >= 0 && et > bt) {//la tâche a pu s'exécuter sur plusieurs machines
+			__atomic_fetch_add(&V->done[t], et - bt, __ATOMIC_RELAXED);
+		}
+		last = max(last, et);
+	}
+}
+
+/**
+ * @brief Seconde passe sur la machine \p m : contrôler que les tâches de ses segments ont exactement
+ * leur durée ordonnancée, jusqu'à la première violation déjà connue.
+ */
+static void check_machine_totals(struct validation_t * V, int m) {
+	const struct machine_schedule_t * MS = get_schedule_of_machine(V->S, m);
+	for (int r = 0; r < MS->size && r < V->firsts[m]; r++) {
+		int j = V->orders[m] != NULL ? V->orders[m][r] : r;
+		int t = V->indices[m][j];
+		if (t >= 0 && V->done[t] != get_task_processing_time(V->tasks[t])) {
+			record_violation(V, m, r, j, VIOLATION_PROCESSING_TIME);
+		}
+	}
+}
+
+static void * validation_worker(void * arg) {
+	struct validation_t * V = arg;
+	int num_m = get_num_machines(V->S);
+	for (int m = __atomic_fetch_add(&V->next_machine, 1, __ATOMIC_RELAXED); m < num_m;
+			m = __atomic_fetch_add(&V->next_machine, 1, __ATOMIC_RELAXED)) {
+		if (V->pass == 0) {
+			check_machine_segments(V, m);
+		} else {
+			check_machine_totals(V, m);
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief Exécuter la passe \p pass sur toutes les machines avec \p num_threads fils d'exécution.
+ */
+static void run_validation_pass(struct validation_t * V, int pass, int num_threads) {
+	V->pass = pass;
+	V->next_machine = 0;
+	pthread_t * threads = (pthread_t *) malloc(num_threads * sizeof(pthread_t));
+	if (threads == NULL) {
+		ShowMessage("src.validator.c:run_validation_pass : allocation impossible", 1);
+	}
+	int started = 0;
+	for (; started < num_threads - 1; started++) {//le fil appelant traite aussi des machines
+		if (pthread_create(&threads[started], NULL, validation_worker, V) != 0) {
+			break;
+		}
+	}
+	validation_worker(V);
+	for (int i = 0; i < started; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	free(threads);
+}
+
+int validate_schedule(const struct schedule_t * S, Instance I, int num_threads,
+						struct schedule_violation_t * violations, int * num_unscheduled) {
+	assert(S != NULL && I != NULL && violations != NULL);
+	int num_m = get_num_machines(S);
+	if (num_threads <= 0) {
+		num_threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+	}
+	num_threads = max(1, min(num_threads, num_m));
+
+	struct validation_t V;
+	V.S = S;
+	V.tasks = new_task_index(I, &V.num_tasks);
+	V.done = (unsigned long *) calloc(V.num_tasks + 1, sizeof(unsigned long));
+	V.indices = (int **) calloc(num_m, sizeof(int *));
+	V.orders = (int **) calloc(num_m, sizeof(int *));
+	V.firsts = (int *) malloc(num_m * sizeof(int));
+	if (V.done == NULL || V.indices == NULL || V.orders == NULL || V.firsts == NULL) {
+		ShowMessage("src.validator.c:validate_schedule : allocation impossible", 1);
+	}
+	V.violations = violations;
+	for (int m = 0; m < num_m; m++) {
+		V.firsts[m] = INT_MAX;
+		violations[m] = (struct schedule_violation_t) { VIOLATION_NONE, -1, NULL };
+	}
+
+	run_validation_pass(&V, 0, num_threads);//les durées cumulées sont complètes après cette passe
+	run_validation_pass(&V, 1, num_threads);
+
+	if (num_unscheduled != NULL) {
+		*num_unscheduled = 0;
+		for (int t = 0; t < V.num_tasks; t++) {
+			if (V.done[t] == 0 && get_task_processing_time(V.tasks[t]) > 0) {
+				(*num_unscheduled)++;
+			}
+		}
+	}
+	int num_invalid = 0;
+	for (int m = 0; m < num_m; m++) {
+		num_invalid += violations[m].type != VIOLATION_NONE;
+		free(V.indices[m]);
+		free(V.orders[m]);
+	}
+	free(V.tasks);
+	free(V.done);
+	free(V.indices);
+	free(V.orders);
+	free(V.firsts);
+	return num_invalid;
+}
+
+/********************************************************************
+ * Lecture d'une solution
+ ********************************************************************/
+
+struct schedule_t * read_solution(const char * filename, Instance I) {
+	assert(filename != NULL && I != NULL);
+	FILE * file = fopen(filename, "r");
+	if (file == NULL) {
+		ShowMessage("src.validator.c:read_solution : fichier impossible à ouvrir", 1);
+	}
+	int num_m;
+	if (fscanf(file, "%d", &num_m) != 1 || num_m < 1) {
+		fclose(file);
+		ShowMessage("src.validator.c:read_solution : nombre de machines invalide", 0);
+		return NULL;
+	}
+	int num_tasks;
+	struct task_t ** tasks = new_task_index(I, &num_tasks);
+	struct schedule_t * S = new_schedule(num_m);
+	if (S == NULL) {
+		ShowMessage("src.validator.c:read_solution : allocation impossible", 1);
+	}
+
+	char token[256], id[256];
+	int machine = -1;
+	char * error = NULL;
+	while (error == NULL && fscanf(file, "%255s", token) == 1) {
+		if (token[0] == 'M') {//début des segments d'une machine
+			machine = atoi(token + 1);
+			if (machine < 0 || machine >= num_m) {
+				error = "src.validator.c:read_solution : machine invalide";
+			}
+			continue;
+		}
+		unsigned long bt = strtoul(token, NULL, 10), et;
+		if (machine < 0 || fscanf(file, "%lu %255s", &et, id) != 2) {
+			error = "src.validator.c:read_solution : segment invalide";
+			break;
+		}
+		int t = find_task_index(tasks, num_tasks, id);
+		if (t < 0) {
+			error = "src.validator.c:read_solution : tâche inconnue";
+		} else if (et <= bt) {
+			error = "src.validator.c:read_solution : segment vide";
+		} else {
+			add_task_to_schedule(S, tasks[t], machine, bt, et);
+		}
+	}
+	fclose(file);
+	free(tasks);
+	if (error != NULL) {
+		ShowMessage(error, 0);
+		delete_schedule(S);
+		return NULL;
+	}
+	return S;
+}